@@ -14,17 +14,20 @@
 (ti-menu-load-string "file/read-colormap colormaps/viridis.colormap\n")
 
 ; allocate and initialize UDMs
-(ti-menu-load-string "define/user-defined/user-defined-memory 6\n")
+(ti-menu-load-string "define/user-defined/user-defined-memory 10\n")
 (ti-menu-load-string "solve/initialize/initialize-flow yes\n")
 
 ; compile and load UDF library
 (ti-menu-load-string "define/user-defined/use-built-in-compiler yes\n")
-(ti-menu-load-string "define/user-defined/compiled-functions compile longwallgobs yes fits.c udf_main.c utils.c \"\" fits.h udf_explosive_mix.h udf_inertia.h udf_permeability.h udf_porosity.h udf_vsi.h utils.h \"\"\n")
+(ti-menu-load-string "define/user-defined/compiled-functions compile longwallgobs yes adaption.c cache.c egz.c explosive_log.c fits.c fits_batch.c flammability.c panel_frame.c params.c properties.c property_export.c sweep.c udf_main.c totals.c utils.c vsi_layout.c vsi_raster.c vsi_stepped.c zone_bounds.c zone_stats.c \"\" adaption.h cache.h egz.h explosive_log.h fits.h fits_batch.h fits_batch_kernel.h fits_expr.h flammability.h omp_loop.h panel_descriptor.h panel_frame.h params.h property_export.h properties.h sweep.h totals.h udf_explosive_mix.h udf_properties.h udf_vsi.h utils.h vsi_layout.h vsi_raster.h vsi_stepped.h zone_bounds.h zone_stats.h \"\"\n")
 (ti-menu-load-string "define/user-defined/compiled-functions load longwallgobs\n")
 
 ; set adjust function hook
 (ti-menu-load-string "define/user-defined/function-hooks/adjust \"demo_calc::longwallgobs\"")
 
+; set execute-at-end function hook (explosive gas zone updates during the solve)
+(ti-menu-load-string "define/user-defined/function-hooks/execute-at-end \"update_explosive_zones::longwallgobs\"")
+
 (ti-menu-load-string "define/models/species/species-transport yes methane-air")
 (ti-menu-load-string "solve/set/number-of-iterations 1")
 (ti-menu-load-string (string-append "solve/initialize/set-defaults species-0 0"))
@@ -32,9 +35,6 @@
 (ti-menu-load-string "solve/initialize/compute-defaults all-zones")
 (ti-menu-load-string "solve/initialize/initialize-flow yes\n")
 
-; compile string parser
-(ti-menu-load-string "! g++ -o parser parser.cpp -static\n")
-
 ; https://stackoverflow.com/questions/29737958/scheme-how-to-find-a-position-of-a-char-in-a-string
 (define (string-search-forward char-list char pos)
   (cond ((null? char-list) #f)              ; list was empty
@@ -85,6 +85,43 @@
      ((equal? item (car list)) (cdr list))
      (else (cons (car list) (delete item (cdr list)))))))
 
+; cell zones assigned a role
+(define (gob-zone-ids)
+	(filter
+		(lambda (id) (> id -1))
+		(map
+			(lambda (role) (rpgetvar (string->symbol (string-append "longwallgobs/" role "_id"))))
+			'("startup_room_center" "startup_room_corner" "mid_panel_center" "mid_panel_gateroad" "working_face_center" "working_face_corner" "single_part_mesh")
+		)
+	)
+)
+
+; porous fluid conditions of a gob zone: resistances and porosity from the profile UDFs or, for static
+; properties, from the zone's profile in longwallgobs-properties.prof (see export_gob_properties)
+(define (set-gob-zone-conditions zone-name static)
+	(define (source udf field)
+		(if static
+			(string-append "\"gob-" (number->string (zone-name->id zone-name)) "\" \"" field "\"")
+			(string-append "\"udf\" \"" udf "::longwallgobs\"")
+		)
+	)
+	(ti-menu-load-string
+		(string-append "/define/boundary-conditions/fluid " zone-name
+			(if (unix?)
+				" no no no no no 0 no 0 no 0 no 0 no 0 no 1 no no no yes no no "
+				" no no no no no 0 no 0 no 0 no 0 no 0 no 1 none no no no yes no no 1 no 0 no 0 no 0 no 1 no 0 yes "
+			)
+			"yes yes " (source "set_perm_1_VSI" "viscous-resistance")
+			" yes yes " (source "set_perm_2_VSI" "viscous-resistance")
+			" yes yes " (source "set_perm_3_VSI" "viscous-resistance")
+			" no yes yes " (source "set_inertia_1_VSI" "inertial-resistance")
+			" yes yes " (source "set_inertia_2_VSI" "inertial-resistance")
+			" yes yes " (source "set_inertia_3_VSI" "inertial-resistance")
+			" 0 0 yes yes " (source "set_poro_VSI" "porosity") " constant 1 no"
+		)
+	)
+)
+
 ; RP Variable Create Function
 (define (make-new-rpvar name default type)
 	(if (not (rp-var-object name))
@@ -117,6 +154,18 @@
 (make-new-rpvar 'longwallgobs/max_vsi 0.40 'real)
 (make-new-rpvar 'longwallgobs/min_inertial_resistance 0 'real)
 (make-new-rpvar 'longwallgobs/max_inertial_resistance 1.3E5 'real)
+(make-new-rpvar 'longwallgobs/vsi_raster_spacing 0 'real)
+(make-new-rpvar 'longwallgobs/cache_fields #t 'boolean)
+(make-new-rpvar 'longwallgobs/static_properties #f 'boolean)
+(make-new-rpvar 'longwallgobs/single_precision #f 'boolean)
+(make-new-rpvar 'longwallgobs/omp_threads 1 'integer)
+(make-new-rpvar 'longwallgobs/egz_max_interval 16 'integer)
+(make-new-rpvar 'longwallgobs/egz_tolerance 0.01 'real)
+(make-new-rpvar 'longwallgobs/flammability_file "" 'string)
+(make-new-rpvar 'longwallgobs/sweep_file "" 'string)
+(make-new-rpvar 'longwallgobs/panel_angle 0 'real)
+(make-new-rpvar 'longwallgobs/fit_precision 0 'integer)
+(make-new-rpvar 'longwallgobs/panel_file "" 'string)
 
 ; Declare Variables for Zone Selection box
 (make-new-rpvar 'longwallgobs/startup_room_center_radio_button #t 'boolean)
@@ -137,7 +186,7 @@
 ; Declare variables for zone info lists
 (make-new-rpvar 'longwallgobs/zone_names_selected '() 'list)
 (make-new-rpvar 'longwallgobs/zone_names '() 'list)
-; Declare variables for zone dimensions
+; Declare variables for zone dimensions (set by measure_zone_bounds, see longwallgobs/panel_file for the alternative)
 (make-new-rpvar 'longwallgobs/startup_room_center_min_x 0 'real)
 (make-new-rpvar 'longwallgobs/startup_room_center_max_x 0 'real)
 (make-new-rpvar 'longwallgobs/startup_room_center_min_y 0 'real)
@@ -209,6 +258,18 @@
         (longwallgobs/max_vsi)
 		(longwallgobs/min_inertial_resistance)
 		(longwallgobs/max_inertial_resistance)
+		(longwallgobs/vsi_raster_spacing)
+		(longwallgobs/omp_threads)
+		(longwallgobs/egz_max_interval)
+		(longwallgobs/egz_tolerance)
+		(longwallgobs/flammability_file)
+		(longwallgobs/sweep_file)
+		(longwallgobs/panel_angle)
+		(longwallgobs/fit_precision)
+		(longwallgobs/cache_button_box)
+		(longwallgobs/cache_fields)
+		(longwallgobs/static_properties)
+		(longwallgobs/single_precision)
 
 		; Zone Selection
 		(table3)
@@ -247,6 +308,17 @@
 			(cx-set-real-entry longwallgobs/max_vsi (rpgetvar 'longwallgobs/max_vsi))
 			(cx-set-real-entry longwallgobs/min_inertial_resistance (rpgetvar 'longwallgobs/min_inertial_resistance))
 			(cx-set-real-entry longwallgobs/max_inertial_resistance (rpgetvar 'longwallgobs/max_inertial_resistance))
+			(cx-set-real-entry longwallgobs/vsi_raster_spacing (rpgetvar 'longwallgobs/vsi_raster_spacing))
+			(cx-set-integer-entry longwallgobs/omp_threads (rpgetvar 'longwallgobs/omp_threads))
+			(cx-set-integer-entry longwallgobs/egz_max_interval (rpgetvar 'longwallgobs/egz_max_interval))
+			(cx-set-real-entry longwallgobs/egz_tolerance (rpgetvar 'longwallgobs/egz_tolerance))
+			(cx-set-text-entry longwallgobs/flammability_file (rpgetvar 'longwallgobs/flammability_file))
+			(cx-set-text-entry longwallgobs/sweep_file (rpgetvar 'longwallgobs/sweep_file))
+			(cx-set-real-entry longwallgobs/panel_angle (rpgetvar 'longwallgobs/panel_angle))
+			(cx-set-integer-entry longwallgobs/fit_precision (rpgetvar 'longwallgobs/fit_precision))
+			(cx-set-toggle-button longwallgobs/cache_fields (rpgetvar 'longwallgobs/cache_fields))
+			(cx-set-toggle-button longwallgobs/static_properties (rpgetvar 'longwallgobs/static_properties))
+			(cx-set-toggle-button longwallgobs/single_precision (rpgetvar 'longwallgobs/single_precision))
 
 
 			; Zone Selection
@@ -287,6 +359,17 @@
 			(rpsetvar 'longwallgobs/max_vsi (cx-show-real-entry longwallgobs/max_vsi))
 			(rpsetvar 'longwallgobs/min_inertial_resistance (cx-show-real-entry longwallgobs/min_inertial_resistance))
 			(rpsetvar 'longwallgobs/max_inertial_resistance (cx-show-real-entry longwallgobs/max_inertial_resistance))
+			(rpsetvar 'longwallgobs/vsi_raster_spacing (cx-show-real-entry longwallgobs/vsi_raster_spacing))
+			(rpsetvar 'longwallgobs/omp_threads (cx-show-integer-entry longwallgobs/omp_threads))
+			(rpsetvar 'longwallgobs/egz_max_interval (cx-show-integer-entry longwallgobs/egz_max_interval))
+			(rpsetvar 'longwallgobs/egz_tolerance (cx-show-real-entry longwallgobs/egz_tolerance))
+			(rpsetvar 'longwallgobs/flammability_file (cx-show-text-entry longwallgobs/flammability_file))
+			(rpsetvar 'longwallgobs/sweep_file (cx-show-text-entry longwallgobs/sweep_file))
+			(rpsetvar 'longwallgobs/panel_angle (cx-show-real-entry longwallgobs/panel_angle))
+			(rpsetvar 'longwallgobs/fit_precision (cx-show-integer-entry longwallgobs/fit_precision))
+			(rpsetvar 'longwallgobs/cache_fields (cx-show-toggle-button longwallgobs/cache_fields))
+			(rpsetvar 'longwallgobs/static_properties (cx-show-toggle-button longwallgobs/static_properties))
+			(rpsetvar 'longwallgobs/single_precision (cx-show-toggle-button longwallgobs/single_precision))
 
 
 
@@ -300,47 +383,18 @@
 			(rpsetvar 'longwallgobs/single_part_mesh_radio_button (cx-show-toggle-button longwallgobs/single_part_mesh_radio_button))
 			(rpsetvar 'longwallgobs/zone_names_selected (cx-show-list-selections longwallgobs/zone_names))
 
-			; Get mesh dimensions from Fluent
-			(if (> (rpgetvar 'longwallgobs/startup_room_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_center_id))) ":1")))) " , x-coordinate yes startup_room_center_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/startup_room_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_center_id))) ":1")))) " , x-coordinate yes startup_room_center_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/startup_room_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_center_id))) ":1")))) " , y-coordinate yes startup_room_center_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/startup_room_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_center_id))) ":1")))) " , y-coordinate yes startup_room_center_max_y.txt no yes")))
-
-			(if (> (rpgetvar 'longwallgobs/startup_room_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_corner_id))) ":1")))) " , x-coordinate yes startup_room_corner_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/startup_room_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_corner_id))) ":1")))) " , x-coordinate yes startup_room_corner_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/startup_room_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_corner_id))) ":1")))) " , y-coordinate yes startup_room_corner_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/startup_room_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/startup_room_corner_id))) ":1")))) " , y-coordinate yes startup_room_corner_max_y.txt no yes")))
-
-			(if (> (rpgetvar 'longwallgobs/mid_panel_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_center_id))) ":1")))) " , x-coordinate yes mid_panel_center_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/mid_panel_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_center_id))) ":1")))) " , x-coordinate yes mid_panel_center_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/mid_panel_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_center_id))) ":1")))) " , y-coordinate yes mid_panel_center_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/mid_panel_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_center_id))) ":1")))) " , y-coordinate yes mid_panel_center_max_y.txt no yes")))
-
-			(if (> (rpgetvar 'longwallgobs/mid_panel_gateroad_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_gateroad_id))) ":1")))) " , x-coordinate yes mid_panel_gateroad_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/mid_panel_gateroad_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_gateroad_id))) ":1")))) " , x-coordinate yes mid_panel_gateroad_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/mid_panel_gateroad_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_gateroad_id))) ":1")))) " , y-coordinate yes mid_panel_gateroad_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/mid_panel_gateroad_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/mid_panel_gateroad_id))) ":1")))) " , y-coordinate yes mid_panel_gateroad_max_y.txt no yes")))
-
-			(if (> (rpgetvar 'longwallgobs/working_face_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_center_id))) ":1")))) " , x-coordinate yes working_face_center_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/working_face_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_center_id))) ":1")))) " , x-coordinate yes working_face_center_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/working_face_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_center_id))) ":1")))) " , y-coordinate yes working_face_center_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/working_face_center_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_center_id))) ":1")))) " , y-coordinate yes working_face_center_max_y.txt no yes")))
-
-			(if (> (rpgetvar 'longwallgobs/working_face_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_corner_id))) ":1")))) " , x-coordinate yes working_face_corner_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/working_face_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_corner_id))) ":1")))) " , x-coordinate yes working_face_corner_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/working_face_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_corner_id))) ":1")))) " , y-coordinate yes working_face_corner_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/working_face_corner_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/working_face_corner_id))) ":1")))) " , y-coordinate yes working_face_corner_max_y.txt no yes")))
-
-			(if (> (rpgetvar 'longwallgobs/single_part_mesh_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/single_part_mesh_id))) ":1")))) " , x-coordinate yes single_part_mesh_min_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/single_part_mesh_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/single_part_mesh_id))) ":1")))) " , x-coordinate yes single_part_mesh_max_x.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/single_part_mesh_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-min " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/single_part_mesh_id))) ":1")))) " , y-coordinate yes single_part_mesh_min_y.txt no yes")))
-			(if (> (rpgetvar 'longwallgobs/single_part_mesh_id) -1) (ti-menu-load-string (string-append (string-append "report/surface-integrals vertex-max " (number->string (surface-name->id (string-insert (symbol->string (zone-id->name (rpgetvar 'longwallgobs/single_part_mesh_id))) ":1")))) " , y-coordinate yes single_part_mesh_max_y.txt no yes")))
-
-			(ti-menu-load-string "! ./parser")
-			(load "set_dimensions.scm")
+			; Get mesh dimensions from Fluent: the UDF measures every selected zone in one pass and sets the
+			; zone bounds RP variables (a panel descriptor named by longwallgobs/panel_file takes precedence)
+			(ti-menu-load-string "define/user-defined/execute-on-demand \"measure_zone_bounds::longwallgobs\"")
 
 			(%run-udf-apply 1)
 
+			; bind the gob zones to the profile UDFs, or export the fields once and bind them as fixed profiles
+			(if (rpgetvar 'longwallgobs/static_properties) (begin
+				(ti-menu-load-string "define/user-defined/execute-on-demand \"export_gob_properties::longwallgobs\"")
+				(ti-menu-load-string "file/read-profile longwallgobs-properties.prof")))
+			(for-each (lambda (id) (set-gob-zone-conditions (symbol->string (zone-id->name id)) (rpgetvar 'longwallgobs/static_properties))) (gob-zone-ids))
+
 			(define surface-append (lambda (zone_name) (surface-name->id(string-insert zone_name ":1"))))
 			(make-new-rpvar 'longwallgobs/surface_list '() 'list)
 			(rpsetvar 'longwallgobs/surface_list (map surface-append zone_names))
@@ -377,10 +431,7 @@
 			(if (and (equal? (cx-show-toggle-button longwallgobs/single_part_mesh_radio_button) #t) (pair? (cx-show-list-selections longwallgobs/zone_names))) (rpsetvar 'longwallgobs/single_part_mesh_id (zone-name->id (list-ref (cx-show-list-selections longwallgobs/zone_names) 0)))) 
 			
 			; Set up zone conditions based on mine selected
-			(if (unix?)
-				(if (pair? (cx-show-list-selections longwallgobs/zone_names)) (ti-menu-load-string (string-append "/define/boundary-conditions/fluid " (string-append (list-ref (cx-show-list-selections longwallgobs/zone_names) 0) " no no no no no 0 no 0 no 0 no 0 no 0 no 1 no no no yes no no yes yes \"udf\" \"set_perm_1_VSI::longwallgobs\" yes yes \"udf\" \"set_perm_2_VSI::longwallgobs\" yes yes \"udf\" \"set_perm_3_VSI::longwallgobs\" no yes yes \"udf\" \"set_inertia_1_VSI::longwallgobs\" yes yes \"udf\" \"set_inertia_2_VSI::longwallgobs\" yes yes \"udf\" \"set_inertia_3_VSI::longwallgobs\" 0 0 yes yes \"udf\" \"set_poro_VSI::longwallgobs\" constant 1 no"))))
-				(if (pair? (cx-show-list-selections longwallgobs/zone_names)) (ti-menu-load-string (string-append "/define/boundary-conditions/fluid " (string-append (list-ref (cx-show-list-selections longwallgobs/zone_names) 0) " no no no no no 0 no 0 no 0 no 0 no 0 no 1 none no no no yes no no 1 no 0 no 0 no 0 no 1 no 0 yes yes yes \"udf\" \"set_perm_1_VSI::longwallgobs\" yes yes \"udf\" \"set_perm_2_VSI::longwallgobs\" yes yes \"udf\" \"set_perm_3_VSI::longwallgobs\" no yes yes \"udf\" \"set_inertia_1_VSI::longwallgobs\" yes yes \"udf\" \"set_inertia_2_VSI::longwallgobs\" yes yes \"udf\" \"set_inertia_3_VSI::longwallgobs\" 0 0 yes yes \"udf\" \"set_poro_VSI::longwallgobs\" constant 1 no"))))
-			)
+			(if (pair? (cx-show-list-selections longwallgobs/zone_names)) (set-gob-zone-conditions (list-ref (cx-show-list-selections longwallgobs/zone_names) 0) #f))
 		)
 
 		(define (init-gas-cb . args)
@@ -440,6 +491,19 @@
 					(set! longwallgobs/max_vsi (cx-create-real-entry longwallgobs/optional_param_table "Max VSI" 'row 1 'col 2))
 					(set! longwallgobs/min_inertial_resistance (cx-create-real-entry longwallgobs/optional_param_table "Min Inertial Resistance" 'row 0 'col 3))
 					(set! longwallgobs/max_inertial_resistance (cx-create-real-entry longwallgobs/optional_param_table "Max Inertial Resistance" 'row 1 'col 3))
+					(set! longwallgobs/vsi_raster_spacing (cx-create-real-entry longwallgobs/optional_param_table "VSI Raster Spacing (0 = Off)" 'row 2 'col 0))
+					(set! longwallgobs/omp_threads (cx-create-integer-entry longwallgobs/optional_param_table "OpenMP Threads per Node" 'row 2 'col 1))
+					(set! longwallgobs/egz_max_interval (cx-create-integer-entry longwallgobs/optional_param_table "Max EGZ Update Interval" 'row 2 'col 2))
+					(set! longwallgobs/egz_tolerance (cx-create-real-entry longwallgobs/optional_param_table "EGZ Volume Tolerance" 'row 2 'col 3))
+					(set! longwallgobs/flammability_file (cx-create-text-entry longwallgobs/optional_param_table "Flammability File (blank = Built-In)" 'row 3 'col 0))
+					(set! longwallgobs/sweep_file (cx-create-text-entry longwallgobs/optional_param_table "Property Sweep File" 'row 3 'col 1))
+					(set! longwallgobs/panel_angle (cx-create-real-entry longwallgobs/optional_param_table "Panel Angle (deg)" 'row 3 'col 2))
+					(set! longwallgobs/fit_precision (cx-create-integer-entry longwallgobs/optional_param_table "Fit Precision (0 Exact, 1 ~1e-7, 2 ~1e-4)" 'row 3 'col 3))
+
+					(set! longwallgobs/cache_button_box (cx-create-button-box table2 "" 'radio-mode #f 'row 1 'col 1))
+					(set! longwallgobs/cache_fields (cx-create-toggle-button longwallgobs/cache_button_box "Cache VSI/Property Fields"))
+					(set! longwallgobs/static_properties (cx-create-toggle-button longwallgobs/cache_button_box "Static Properties (Profile File)"))
+					(set! longwallgobs/single_precision (cx-create-toggle-button longwallgobs/cache_button_box "Single Precision (float32) Fits/Resistances"))
 
 					; Zone Selection
 					(set! table3 (cx-create-table ttab3 ""))
@@ -0,0 +1,33 @@
+/**
+ * @file adaption.h
+ *
+ * @brief Fields of the cells a mesh adaption added. Refining or coarsening
+ * leaves the new cells with zero user-defined memory, or with a copy of their
+ * parent's, so their panel coordinates (udm-8/9) no longer match their
+ * centroids. Those cells, and only those, get the VSI and gob properties the
+ * other cells were computed with; the fits run over them alone. See
+ * README.md, "Mesh Adaption".
+ */
+
+#ifndef GOB_ADAPTION_H
+#define GOB_ADAPTION_H
+
+#include "udf.h" // Fluent macros
+
+#include "params.h" // for struct gob_params
+
+/**
+ * @brief Maps every cell centroid into the panel frame and, for each cell
+ * whose stored panel coordinates differ, stores the new ones and computes
+ * udm-6, 4, 1, 0 and 5 as udf_main would. Node only and without
+ * communication, so a node may call it alone.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] params parameters the other cells were computed from (cells
+ * whose coordinates are of another frame, or missing, are computed too)
+ * @return [int] cells computed, or -1 if out of memory (some new cells left
+ * as they were)
+ */
+int gob_adaption_refresh(Domain *d, const struct gob_params *params);
+
+#endif // GOB_ADAPTION_H
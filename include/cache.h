@@ -0,0 +1,59 @@
+/**
+ * @file cache.h
+ *
+ * @brief On-disk cache of the computed VSI and gob property fields. The
+ * cached user-defined-memory slots (0, 1, 4, 5 and 6) are keyed by a hash of
+ * the cell centroids and the parameter snapshot (params.h), so a restart with
+ * an unchanged mesh and setup can reload them instead of re-evaluating every
+ * fit.
+ */
+
+#ifndef GOB_CACHE_H
+#define GOB_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "udf.h" // Fluent macros, real typedef
+
+#include "params.h" // for struct gob_params
+
+/**
+ * @brief Hashes everything the VSI and property fields depend on.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] params parameters the fields are computed from
+ * @return [uint64_t] key identifying the mesh + parameter set
+ */
+uint64_t gob_cache_key(Domain *d, const struct gob_params *params);
+
+/**
+ * @brief Reloads the cached fields straight into C_UDMI.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] key expected key (see gob_cache_key)
+ * @return [true] cache file matched and all slots were restored
+ * @return [false] no usable cache; fields must be recomputed
+ */
+bool gob_cache_load(Domain *d, const uint64_t key);
+
+/**
+ * @brief Writes the current contents of the cached slots to disk.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] key key the fields were computed for
+ * @return [true] cache file written
+ * @return [false] file could not be written
+ */
+bool gob_cache_save(Domain *d, const uint64_t key);
+
+/**
+ * @brief Hashes the current contents of the cached slots, to tell whether
+ * the fields still hold what was last computed or loaded.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @return [uint64_t] hash of every cached slot of every cell (never 0)
+ */
+uint64_t gob_fields_hash(Domain *d);
+
+#endif // GOB_CACHE_H
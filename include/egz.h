@@ -0,0 +1,81 @@
+/**
+ * @file egz.h
+ *
+ * @brief Explosive gas zone (EGZ) classes of a methane-air mixture on the
+ * Coward diagram, from the methane and oxygen mass fractions.
+ *
+ * Every boundary of the diagram is a straight line in mole fractions, and the
+ * mass -> mole fraction map sends straight lines to straight lines. So each
+ * boundary stays a line over (Y_CH4, Y_O2). That makes it cheap to find the
+ * cells of a regular grid over the mass fractions that no boundary comes near.
+ * Those cells store their class in a lookup table. All others (and mass
+ * fractions outside [0, 1)) fall back to the exact classifier, so the table
+ * never changes a class.
+ */
+
+#ifndef GOB_EGZ_H
+#define GOB_EGZ_H
+
+#include "udf.h" // real typedef
+
+/* classes in the order the exact classifier tests them; also stored in udm-7 */
+enum egz_class {
+	EGZ_EXPLOSIVE, // red
+	EGZ_NEAR_EXPLOSIVE, // orange
+	EGZ_FUEL_RICH_INERT, // yellow
+	EGZ_OXYGEN_LEAN_INERT_A, // green A
+	EGZ_OXYGEN_LEAN_INERT_DARK, // dark green
+	EGZ_OXYGEN_LEAN_INERT_B, // green B
+	EGZ_OXYGEN_RICH_INERT, // cyan
+	EGZ_UNCLASSIFIED, // dark blue; nothing else matched
+	EGZ_N_CLASSES
+};
+
+/* lookup table entry of a grid cell a boundary passes close to */
+#define EGZ_BOUNDARY 0xff
+
+/* lookup table cells along each mass fraction axis */
+#define EGZ_LUT_N 256
+
+extern unsigned char egz_lut[EGZ_LUT_N][EGZ_LUT_N];
+
+/* colormap value of each class, as displayed from udm-2 */
+extern const real EGZ_DISPLAY[EGZ_N_CLASSES];
+
+/**
+ * @brief Fills the lookup table; only the first call does any work. Call it
+ * outside of parallel regions before egz_classify.
+ */
+void egz_lut_build(void);
+
+/**
+ * @brief Classifies a mixture by walking every boundary of the diagram.
+ *
+ * @param [in] Y_CH4 methane mass fraction
+ * @param [in] Y_O2 oxygen mass fraction
+ * @return [int] enum egz_class
+ */
+int egz_classify_exact(const real Y_CH4, const real Y_O2);
+
+/**
+ * @brief Classifies a mixture from the lookup table, falling back to
+ * egz_classify_exact near the boundaries. Same result as egz_classify_exact.
+ *
+ * @param [in] Y_CH4 methane mass fraction
+ * @param [in] Y_O2 oxygen mass fraction
+ * @return [int] enum egz_class
+ */
+static inline int egz_classify(const real Y_CH4, const real Y_O2)
+{
+	// also rejects NaN
+	if (Y_CH4 >= 0 && Y_CH4 < 1 && Y_O2 >= 0 && Y_O2 < 1) {
+		const int CODE = egz_lut[(int)(Y_O2 * EGZ_LUT_N)][(int)(Y_CH4 * EGZ_LUT_N)];
+
+		if (CODE != EGZ_BOUNDARY)
+			return CODE;
+	}
+
+	return egz_classify_exact(Y_CH4, Y_O2);
+}
+
+#endif // GOB_EGZ_H
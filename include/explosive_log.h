@@ -0,0 +1,26 @@
+/**
+ * @file explosive_log.h
+ *
+ * @brief Time series of the explosive gas volume, so it can be monitored while
+ * the solution runs without a Volume-Integral report. One line per update is
+ * appended to longwallgobs-explosive.log:
+ *	iteration flow_time explosive_volume
+ * (flow_time stays 0 in steady runs).
+ */
+
+#ifndef GOB_EXPLOSIVE_LOG_H
+#define GOB_EXPLOSIVE_LOG_H
+
+#include "udf.h" // Fluent macros, real typedef
+
+/**
+ * @brief Appends one line to the log, creating it with a header if needed.
+ * Only node zero (or the serial process) writes; other processes return.
+ *
+ * @param [in] iteration solver iteration count
+ * @param [in] flow_time physical time of a transient run (s)
+ * @param [in] explosive_volume globally reduced explosive volume (m^3)
+ */
+void gob_explosive_log_append(const int iteration, const real flow_time, const real explosive_volume);
+
+#endif // GOB_EXPLOSIVE_LOG_H
@@ -0,0 +1,92 @@
+/**
+ * @file fits_batch.h
+ *
+ * @brief Batched versions of the equation fits in fits.h. Each *_n function
+ * evaluates its fit over n contiguous points, writing out[i] = fit(x[i], y[i]).
+ *
+ * On x86-64 the work runs 8 lanes at a time with AVX-512 or 4 lanes at a time
+ * with AVX2/FMA, picked at runtime from the CPU (or forced with the
+ * GOB_FITS_BATCH environment variable: "scalar", "avx2" or "avx512"); other
+ * CPUs loop over the scalar fits. Vector results differ from the scalar fits
+ * by at most FITS_BATCH_MAX_ULP units in the last place of max(|fit|, 1), see
+ * fits_batch.c.
+ *
+ * fits_batch_set_precision trades that accuracy for speed: the faster tiers
+ * use shorter exp/log polynomials on the vector paths and skip the lanes whose
+ * terms underflow, or evaluate in float on twice as many lanes. Every 64th
+ * point they compute is checked against the exact scalar fit, and
+ * fits_batch_precision_error reports the worst.
+ */
+
+#ifndef GOB_FITS_BATCH_H
+#define GOB_FITS_BATCH_H
+
+/* accuracy bound of the vector paths, see fits_batch.c */
+#define FITS_BATCH_MAX_ULP 8
+
+/* accuracy tiers of the vector paths, longwallgobs/fit_precision */
+enum fits_precision {
+	FITS_PRECISION_EXACT, // within FITS_BATCH_MAX_ULP
+	FITS_PRECISION_1E7, // about 1e-7 of max(|fit|, 1)
+	FITS_PRECISION_1E4, // about 1e-4 of max(|fit|, 1)
+	FITS_PRECISION_FLOAT32, // float arithmetic on twice the lanes, about 1e-6
+};
+
+/**
+ * @brief Selects the accuracy tier of the following batches and clears the
+ * sampled error. Not thread-safe; call it outside the parallel regions.
+ *
+ * @param [in] tier enum fits_precision, anything else selects exact
+ */
+void fits_batch_set_precision(const int tier);
+
+/**
+ * @brief Largest error, relative to max(|fit|, 1), of the points sampled
+ * since the last fits_batch_set_precision (0 in the exact tier or on the
+ * scalar path, which is always exact).
+ *
+ * @return [double] sampled error
+ */
+double fits_batch_precision_error(void);
+
+/**
+ * @brief Name of the instruction set the batched fits run on.
+ *
+ * @return [const char *] "avx512", "avx2" or "scalar"
+ */
+const char *fits_batch_isa(void);
+
+/*******************************************************************************
+ * TRONA MINE
+ * SUB CRITICAL PANEL
+*******************************************************************************/
+
+void sub_critical_trona_working_face_corner_n(const double *x, const double *y, double *out, const int n);
+void sub_critical_trona_mid_panel_gateroad_n(const double *x, double *out, const int n);
+void sub_critical_trona_startup_room_corner_n(const double *x, const double *y, double *out, const int n);
+
+/*******************************************************************************
+ * MINE E
+ * SUPER CRITICAL PANEL
+*******************************************************************************/
+
+void super_critical_mine_E_startup_room_center_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_E_mid_panel_center_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_E_working_face_center_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_E_working_face_corner_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_E_startup_room_corner_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_E_mid_panel_gateroad_n(const double *x, const double *y, double *out, const int n);
+
+/*******************************************************************************
+ * MINE C
+ * SUPER CRITICAL PANEL
+*******************************************************************************/
+
+void super_critical_mine_C_startup_room_center_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_C_mid_panel_center_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_C_working_face_center_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_C_working_face_corner_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_C_startup_room_corner_n(const double *x, const double *y, double *out, const int n);
+void super_critical_mine_C_mid_panel_gateroad_n(const double *x, const double *y, double *out, const int n);
+
+#endif // GOB_FITS_BATCH_H
@@ -0,0 +1,451 @@
+/**
+ * @file fits_batch_kernel.h
+ *
+ * @brief Vector kernels of the batched fits, instantiated once per
+ * instruction set by fits_batch.c, and within it once per precision tier
+ * (fits_batch.h): name for the exact tier, name_p7 and name_p4 for the
+ * shorter double polynomials, name_f32 for float arithmetic on twice the
+ * lanes. Not a public header.
+ *
+ * Before including, define:
+ *   BATCH_WIDTH  lanes per vector (4 or 8)
+ *   BATCH_TARGET target attribute string (e.g. "avx2,fma")
+ *   BATCH(name)  name mangling for this instantiation (e.g. name##_avx2)
+ */
+
+#define BATCH_KERNEL static inline __attribute__((target(BATCH_TARGET)))
+
+typedef double BATCH(vd) __attribute__((vector_size(BATCH_WIDTH * sizeof(double))));
+typedef long long BATCH(vl) __attribute__((vector_size(BATCH_WIDTH * sizeof(long long))));
+typedef unsigned long long BATCH(vu) __attribute__((vector_size(BATCH_WIDTH * sizeof(long long))));
+
+/* lane-wise mask ? a : b (mask lanes are all ones or all zeros) */
+BATCH_KERNEL BATCH(vd) BATCH(select)(const BATCH(vl) mask, const BATCH(vd) a, const BATCH(vd) b)
+{
+	return (BATCH(vd))(((BATCH(vl))a & mask) | ((BATCH(vl))b & ~mask));
+}
+
+/* round to nearest integer, valid for |x| < 2^51 */
+BATCH_KERNEL BATCH(vd) BATCH(round)(const BATCH(vd) x)
+{
+	return (x + ROUND_SHIFT) - ROUND_SHIFT;
+}
+
+/* 2^k for integral k in [-1022, 1023] */
+BATCH_KERNEL BATCH(vd) BATCH(pow2)(const BATCH(vd) k)
+{
+	// the low mantissa bits of k + ROUND_SHIFT hold k as an integer
+	const BATCH(vl) K = (BATCH(vl))(k + ROUND_SHIFT) - ROUND_SHIFT_BITS;
+
+	return (BATCH(vd))((K + 1023) << 52);
+}
+
+/* all lanes of x below a threshold */
+BATCH_KERNEL int BATCH(all_below)(const BATCH(vd) x, const double threshold)
+{
+	int below = 0;
+
+	for (int j = 0; j < BATCH_WIDTH; ++j)
+		below += x[j] < threshold;
+
+	return below == BATCH_WIDTH;
+}
+
+/* exp(x) with the Taylor series of exp(r) to the given degree, 0 below flush;
+   within 1 ULP of the C library for the whole double range at degree 13 and
+   flush -746 (where exp underflows anyway) */
+BATCH_KERNEL BATCH(vd) BATCH(exp_tier)(const BATCH(vd) x, const int degree, const double flush)
+{
+	const BATCH(vd) ZERO = { 0 };
+
+	// a term that vanishes in every lane costs nothing
+	if (BATCH(all_below)(x, flush))
+		return ZERO;
+
+	// x = k ln(2) + r with |r| <= ln(2) / 2
+	BATCH(vd) k = BATCH(round)(x * LOG2_E);
+	const BATCH(vd) r = (x - k * LN2_HI) - k * LN2_LO;
+
+	// Taylor series of exp(r), Horner form, truncation error < 2^-60 at degree 13
+	BATCH(vd) p = ZERO + EXP_TAYLOR[degree];
+
+#pragma GCC unroll 16
+	for (int j = degree - 1; j >= 0; --j)
+		p = p * r + EXP_TAYLOR[j];
+
+	// keep 2^k representable: shift subnormal results and k = 1024 into range
+	const BATCH(vl) UNDER = x < -708.0;
+	const BATCH(vl) OVER = x > 709.0;
+
+	k = k + BATCH(select)(UNDER, ZERO + 54.0, BATCH(select)(OVER, ZERO - 1.0, ZERO));
+	p = p * BATCH(select)(UNDER, ZERO + 0x1p-54, BATCH(select)(OVER, ZERO + 2.0, ZERO + 1.0));
+
+	BATCH(vd) result = p * BATCH(pow2)(k);
+
+	// saturate outside the representable range (or the tier's), NaN stays NaN
+	result = BATCH(select)(x < flush, ZERO, result);
+	result = BATCH(select)(x > 710.0, ZERO + __builtin_inf(), result);
+
+	return result;
+}
+
+/* log(x) with the first terms (2, 4 or all 7) of R(z); within 1 ULP of the C
+   library (fdlibm's e_log.c reduction) with all of them */
+BATCH_KERNEL BATCH(vd) BATCH(log_tier)(const BATCH(vd) x, const int terms)
+{
+	const BATCH(vd) ZERO = { 0 };
+
+	// scale subnormals into the normal range
+	const BATCH(vl) SUBNORMAL = x < 0x1p-1022;
+	const BATCH(vd) X = x * BATCH(select)(SUBNORMAL, ZERO + 0x1p54, ZERO + 1.0);
+	BATCH(vd) k = BATCH(select)(SUBNORMAL, ZERO - 54.0, ZERO);
+
+	// x = 2^k m with m in [sqrt(2)/2, sqrt(2))
+	const BATCH(vu) BITS = (BATCH(vu))X;
+	BATCH(vd) m = (BATCH(vd))((BITS & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+	const BATCH(vl) E = (BATCH(vl))(BITS >> 52) - 1023;
+
+	// exponent to double, the inverse of the ROUND_SHIFT trick in pow2
+	k = k + ((BATCH(vd))(E + ROUND_SHIFT_BITS) - ROUND_SHIFT);
+
+	const BATCH(vl) HIGH = m > SQRT_2;
+	m = BATCH(select)(HIGH, m * 0.5, m);
+	k = k + BATCH(select)(HIGH, ZERO + 1.0, ZERO);
+
+	// log(m) = f - f^2/2 + s (f^2/2 + R(s^2)), s = f / (2 + f)
+	const BATCH(vd) f = m - 1.0;
+	const BATCH(vd) hfsq = 0.5 * f * f;
+	const BATCH(vd) s = f / (2.0 + f);
+	const BATCH(vd) z = s * s;
+	BATCH(vd) R;
+
+	if (terms >= 7) {
+		const BATCH(vd) w = z * z;
+		const BATCH(vd) t1 = w * (LG2 + w * (LG4 + w * LG6));
+		const BATCH(vd) t2 = z * (LG1 + w * (LG3 + w * (LG5 + w * LG7)));
+		R = t2 + t1;
+	} else if (terms >= 4) {
+		R = z * (LG1 + z * (LG2 + z * (LG3 + z * LG4)));
+	} else {
+		R = z * (LG1 + z * LG2);
+	}
+
+	BATCH(vd) result = k * LN2_HI - ((hfsq - (s * (hfsq + R) + k * LN2_LO)) - f);
+
+	// log(0) = -inf, log(inf) = inf, log(x < 0) = log(NaN) = NaN
+	result = BATCH(select)(x == 0.0, ZERO - __builtin_inf(), result);
+	result = BATCH(select)(x == __builtin_inf(), x, result);
+	result = BATCH(select)((x < 0.0) | (x != x), ZERO + __builtin_nan(""), result);
+
+	return result;
+}
+
+/* exp and pow(a, b) (a >= 0 and a scalar exponent, the only form the fits use)
+   of a precision tier, named by suffix, with the PARAMS##_* settings of fits_batch.c */
+#define BATCH_TIER(suffix, PARAMS)                                                                      \
+	BATCH_KERNEL BATCH(vd) BATCH(exp##suffix)(const BATCH(vd) x)                                    \
+	{                                                                                               \
+		return BATCH(exp_tier)(x, PARAMS##_EXP_DEGREE, PARAMS##_EXP_FLUSH);                     \
+	}                                                                                               \
+                                                                                                        \
+	BATCH_KERNEL BATCH(vd) BATCH(pow##suffix)(const BATCH(vd) a, const double b)                    \
+	{                                                                                               \
+		return BATCH(exp_tier)(b * BATCH(log_tier)(a, PARAMS##_LOG_TERMS), PARAMS##_EXP_DEGREE, \
+				       PARAMS##_EXP_FLUSH);                                             \
+	}
+
+BATCH_TIER(, EXACT)
+BATCH_TIER(_p7, P7)
+BATCH_TIER(_p4, P4)
+
+/* clamp_positive, lane-wise (NaN passes through like the scalar version) */
+BATCH_KERNEL BATCH(vd) BATCH(clamp_positive)(const BATCH(vd) v)
+{
+	const BATCH(vd) ZERO = { 0 };
+
+	return BATCH(select)(v < 0.0, ZERO, v);
+}
+
+/* batched fit of x and y in a precision tier; the tail is padded with in-range points */
+#define BATCH_FIT_XY(name, suffix)                                                                                            \
+	static __attribute__((target(BATCH_TARGET))) void BATCH(name##suffix)(const double *x, const double *y,               \
+									 double *out, const int n)                            \
+	{                                                                                                                     \
+		int i = 0;                                                                                                    \
+                                                                                                                              \
+		for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {                                                              \
+			BATCH(vd) X, Y;                                                                                       \
+			memcpy(&X, x + i, sizeof(X));                                                                         \
+			memcpy(&Y, y + i, sizeof(Y));                                                                         \
+                                                                                                                              \
+			const BATCH(vd) V =                                                                                   \
+				BATCH(clamp_positive)(name##_expr(FIT_DOUBLE, BATCH(exp##suffix), BATCH(pow##suffix), X, Y)); \
+			memcpy(out + i, &V, sizeof(V));                                                                       \
+		}                                                                                                             \
+                                                                                                                              \
+		if (i < n) {                                                                                                  \
+			BATCH(vd) X, Y;                                                                                       \
+			for (int j = 0; j < BATCH_WIDTH; ++j) {                                                               \
+				X[j] = (i + j < n) ? x[i + j] : 0.5;                                                          \
+				Y[j] = (i + j < n) ? y[i + j] : 0.5;                                                          \
+			}                                                                                                     \
+                                                                                                                              \
+			const BATCH(vd) V =                                                                                   \
+				BATCH(clamp_positive)(name##_expr(FIT_DOUBLE, BATCH(exp##suffix), BATCH(pow##suffix), X, Y)); \
+			memcpy(out + i, &V, (n - i) * sizeof(double));                                                        \
+		}                                                                                                             \
+	}
+
+/* batched fit of x only in a precision tier */
+#define BATCH_FIT_X(name, suffix)                                                                                                      \
+	static __attribute__((target(BATCH_TARGET))) void BATCH(name##suffix)(const double *x, double *out,                            \
+									 const int n)                                                  \
+	{                                                                                                                              \
+		int i = 0;                                                                                                             \
+                                                                                                                                       \
+		for (; i + BATCH_WIDTH <= n; i += BATCH_WIDTH) {                                                                       \
+			BATCH(vd) X;                                                                                                   \
+			memcpy(&X, x + i, sizeof(X));                                                                                  \
+                                                                                                                                       \
+			const BATCH(vd) V = BATCH(clamp_positive)(name##_expr(FIT_DOUBLE, BATCH(exp##suffix), BATCH(pow##suffix), X)); \
+			memcpy(out + i, &V, sizeof(V));                                                                                \
+		}                                                                                                                      \
+                                                                                                                                       \
+		if (i < n) {                                                                                                           \
+			BATCH(vd) X;                                                                                                   \
+			for (int j = 0; j < BATCH_WIDTH; ++j)                                                                          \
+				X[j] = (i + j < n) ? x[i + j] : 0.5;                                                                   \
+                                                                                                                                       \
+			const BATCH(vd) V = BATCH(clamp_positive)(name##_expr(FIT_DOUBLE, BATCH(exp##suffix), BATCH(pow##suffix), X)); \
+			memcpy(out + i, &V, (n - i) * sizeof(double));                                                                 \
+		}                                                                                                                      \
+	}
+
+/* every fit in one precision tier */
+#define BATCH_FITS(suffix)                                              \
+	BATCH_FIT_XY(sub_critical_trona_working_face_corner, suffix)    \
+	BATCH_FIT_X(sub_critical_trona_mid_panel_gateroad, suffix)      \
+	BATCH_FIT_XY(sub_critical_trona_startup_room_corner, suffix)    \
+                                                                        \
+	BATCH_FIT_XY(super_critical_mine_E_startup_room_center, suffix) \
+	BATCH_FIT_XY(super_critical_mine_E_mid_panel_center, suffix)    \
+	BATCH_FIT_XY(super_critical_mine_E_working_face_center, suffix) \
+	BATCH_FIT_XY(super_critical_mine_E_working_face_corner, suffix) \
+	BATCH_FIT_XY(super_critical_mine_E_startup_room_corner, suffix) \
+	BATCH_FIT_XY(super_critical_mine_E_mid_panel_gateroad, suffix)  \
+                                                                        \
+	BATCH_FIT_XY(super_critical_mine_C_startup_room_center, suffix) \
+	BATCH_FIT_XY(super_critical_mine_C_mid_panel_center, suffix)    \
+	BATCH_FIT_XY(super_critical_mine_C_working_face_center, suffix) \
+	BATCH_FIT_XY(super_critical_mine_C_working_face_corner, suffix) \
+	BATCH_FIT_XY(super_critical_mine_C_startup_room_corner, suffix) \
+	BATCH_FIT_XY(super_critical_mine_C_mid_panel_gateroad, suffix)
+
+BATCH_FITS()
+BATCH_FITS(_p7)
+BATCH_FITS(_p4)
+
+/* FLOAT32 TIER ***************************************************************/
+
+/* twice the lanes in the same register width */
+typedef float BATCH(vf) __attribute__((vector_size(2 * BATCH_WIDTH * sizeof(float))));
+typedef int BATCH(vi) __attribute__((vector_size(2 * BATCH_WIDTH * sizeof(int))));
+
+BATCH_KERNEL BATCH(vf) BATCH(select_f32)(const BATCH(vi) mask, const BATCH(vf) a, const BATCH(vf) b)
+{
+	return (BATCH(vf))(((BATCH(vi))a & mask) | ((BATCH(vi))b & ~mask));
+}
+
+BATCH_KERNEL int BATCH(all_below_f32)(const BATCH(vf) x, const float threshold)
+{
+	int below = 0;
+
+	for (int j = 0; j < 2 * BATCH_WIDTH; ++j)
+		below += x[j] < threshold;
+
+	return below == 2 * BATCH_WIDTH;
+}
+
+/* exp(x) in float: 0 below F32_EXP_FLUSH, inf above 88 (and NaN stays NaN) */
+BATCH_KERNEL BATCH(vf) BATCH(exp_f32)(const BATCH(vf) x)
+{
+	const BATCH(vf) ZERO = { 0 };
+
+	if (BATCH(all_below_f32)(x, F32_EXP_FLUSH))
+		return ZERO;
+
+	// x = k ln(2) + r with |r| <= ln(2) / 2, |k| <= 127 in range
+	const BATCH(vf) k = (x * LOG2_E_F32 + ROUND_SHIFT_F32) - ROUND_SHIFT_F32;
+	const BATCH(vf) r = (x - k * LN2_HI_F32) - k * LN2_LO_F32;
+
+	BATCH(vf) p = ZERO + (float)EXP_TAYLOR[F32_EXP_DEGREE];
+
+#pragma GCC unroll 16
+	for (int j = F32_EXP_DEGREE - 1; j >= 0; --j)
+		p = p * r + (float)EXP_TAYLOR[j];
+
+	// 2^k from the low mantissa bits of k + ROUND_SHIFT_F32
+	const BATCH(vi) K = (BATCH(vi))(k + ROUND_SHIFT_F32) - ROUND_SHIFT_F32_BITS;
+	BATCH(vf) result = p * (BATCH(vf))((K + 127) << 23);
+
+	result = BATCH(select_f32)(x < F32_EXP_FLUSH, ZERO, result);
+	result = BATCH(select_f32)(x > 88.0f, ZERO + __builtin_inff(), result);
+
+	return result;
+}
+
+/* log(x) in float, fdlibm's e_logf.c reduction with four terms of R(z) */
+BATCH_KERNEL BATCH(vf) BATCH(log_f32)(const BATCH(vf) x)
+{
+	const BATCH(vf) ZERO = { 0 };
+
+	// scale subnormals into the normal range
+	const BATCH(vi) SUBNORMAL = x < 0x1p-126f;
+	const BATCH(vf) X = x * BATCH(select_f32)(SUBNORMAL, ZERO + 0x1p24f, ZERO + 1.0f);
+	BATCH(vf) k = BATCH(select_f32)(SUBNORMAL, ZERO - 24.0f, ZERO);
+
+	// x = 2^k m with m in [sqrt(2)/2, sqrt(2))
+	const BATCH(vi) BITS = (BATCH(vi))X;
+	BATCH(vf) m = (BATCH(vf))((BITS & 0x007fffff) | 0x3f800000);
+	k = k + __builtin_convertvector(((BITS >> 23) & 0xff) - 127, BATCH(vf));
+
+	const BATCH(vi) HIGH = m > SQRT_2_F32;
+	m = BATCH(select_f32)(HIGH, m * 0.5f, m);
+	k = k + BATCH(select_f32)(HIGH, ZERO + 1.0f, ZERO);
+
+	const BATCH(vf) f = m - 1.0f;
+	const BATCH(vf) hfsq = 0.5f * f * f;
+	const BATCH(vf) s = f / (2.0f + f);
+	const BATCH(vf) z = s * s;
+	const BATCH(vf) R = z * (LG1_F32 + z * (LG2_F32 + z * (LG3_F32 + z * LG4_F32)));
+
+	BATCH(vf) result = k * LN2_HI_F32 - ((hfsq - (s * (hfsq + R) + k * LN2_LO_F32)) - f);
+
+	result = BATCH(select_f32)(x == 0.0f, ZERO - __builtin_inff(), result);
+	result = BATCH(select_f32)(x == __builtin_inff(), x, result);
+	result = BATCH(select_f32)((x < 0.0f) | (x != x), ZERO + __builtin_nanf(""), result);
+
+	return result;
+}
+
+BATCH_KERNEL BATCH(vf) BATCH(pow_f32)(const BATCH(vf) a, const double b)
+{
+	return BATCH(exp_f32)((float)b * BATCH(log_f32)(a));
+}
+
+BATCH_KERNEL BATCH(vf) BATCH(clamp_positive_f32)(const BATCH(vf) v)
+{
+	const BATCH(vf) ZERO = { 0 };
+
+	return BATCH(select_f32)(v < 0.0f, ZERO, v);
+}
+
+/* 2 * BATCH_WIDTH doubles narrowed to float (lane loops compile to a
+   conversion per register width) */
+BATCH_KERNEL BATCH(vf) BATCH(narrow)(const double *p)
+{
+	BATCH(vf) v;
+
+	for (int j = 0; j < 2 * BATCH_WIDTH; ++j)
+		v[j] = (float)p[j];
+
+	return v;
+}
+
+/* widens V into 2 * BATCH_WIDTH doubles; nonzero if some lane left the float
+   range (overflowed or NaN) */
+BATCH_KERNEL int BATCH(widen)(const BATCH(vf) V, double *p)
+{
+	const BATCH(vi) BAD = (V > __FLT_MAX__) | (V != V);
+	int any = 0;
+
+	for (int j = 0; j < 2 * BATCH_WIDTH; ++j) {
+		p[j] = V[j];
+		any |= BAD[j];
+	}
+
+	return any;
+}
+
+/* one float32 vector of a fit at i: narrowed inputs (the tail padded with
+   in-range points), widened results, and the lanes out of the float range
+   evaluated again by the scalar (double) fit */
+#define BATCH_F32_STEP(name, SCALAR, ...)                                                                               \
+	do {                                                                                                            \
+		const int COUNT = n - i < 2 * BATCH_WIDTH ? n - i : 2 * BATCH_WIDTH;                                    \
+		double xs[2 * BATCH_WIDTH], ys[2 * BATCH_WIDTH], vs[2 * BATCH_WIDTH];                                   \
+		const double *X_IN = x + i, *Y_IN = y + i;                                                              \
+		double *V_OUT = COUNT == 2 * BATCH_WIDTH ? out + i : vs;                                                \
+                                                                                                                        \
+		if (COUNT < 2 * BATCH_WIDTH) {                                                                          \
+			for (int j = 0; j < 2 * BATCH_WIDTH; ++j) {                                                     \
+				xs[j] = j < COUNT ? x[i + j] : 0.5;                                                     \
+				ys[j] = j < COUNT ? y[i + j] : 0.5;                                                     \
+			}                                                                                               \
+			X_IN = xs;                                                                                      \
+			Y_IN = ys;                                                                                      \
+		}                                                                                                       \
+                                                                                                                        \
+		const BATCH(vf) X = BATCH(narrow)(X_IN);                                                                \
+		const BATCH(vf) Y = BATCH(narrow)(Y_IN);                                                                \
+		const BATCH(vf) V =                                                                                     \
+			BATCH(clamp_positive_f32)(name##_expr(FIT_FLOAT, BATCH(exp_f32), BATCH(pow_f32), __VA_ARGS__)); \
+		const int BAD = BATCH(widen)(V, V_OUT);                                                                 \
+		(void)Y; /* unused by the x-only fits */                                                                \
+                                                                                                                        \
+		if (V_OUT == vs)                                                                                        \
+			memcpy(out + i, vs, COUNT * sizeof(double));                                                    \
+                                                                                                                        \
+		if (BAD)                                                                                                \
+			for (int j = 0; j < COUNT; ++j)                                                                 \
+				if (!(out[i + j] <= __DBL_MAX__))                                                       \
+					out[i + j] = SCALAR;                                                            \
+	} while (0)
+
+/* batched fit of x and y in float32, 2 * BATCH_WIDTH points at a time */
+#define BATCH_FIT_XY_F32(name)                                                                                \
+	static __attribute__((target(BATCH_TARGET))) void BATCH(name##_f32)(const double *x, const double *y, \
+									   double *out, const int n)          \
+	{                                                                                                     \
+		for (int i = 0; i < n; i += 2 * BATCH_WIDTH)                                                  \
+			BATCH_F32_STEP(name, name(x[i + j], y[i + j]), X, Y);                                 \
+	}
+
+/* batched fit of x only in float32 (y is x, unused) */
+#define BATCH_FIT_X_F32(name)                                                                             \
+	static __attribute__((target(BATCH_TARGET))) void BATCH(name##_f32)(const double *x, double *out, \
+									   const int n)                   \
+	{                                                                                                 \
+		const double *y = x;                                                                      \
+                                                                                                          \
+		for (int i = 0; i < n; i += 2 * BATCH_WIDTH)                                              \
+			BATCH_F32_STEP(name, name(x[i + j]), X);                                          \
+	}
+
+BATCH_FIT_XY_F32(sub_critical_trona_working_face_corner)
+BATCH_FIT_X_F32(sub_critical_trona_mid_panel_gateroad)
+BATCH_FIT_XY_F32(sub_critical_trona_startup_room_corner)
+
+BATCH_FIT_XY_F32(super_critical_mine_E_startup_room_center)
+BATCH_FIT_XY_F32(super_critical_mine_E_mid_panel_center)
+BATCH_FIT_XY_F32(super_critical_mine_E_working_face_center)
+BATCH_FIT_XY_F32(super_critical_mine_E_working_face_corner)
+BATCH_FIT_XY_F32(super_critical_mine_E_startup_room_corner)
+BATCH_FIT_XY_F32(super_critical_mine_E_mid_panel_gateroad)
+
+BATCH_FIT_XY_F32(super_critical_mine_C_startup_room_center)
+BATCH_FIT_XY_F32(super_critical_mine_C_mid_panel_center)
+BATCH_FIT_XY_F32(super_critical_mine_C_working_face_center)
+BATCH_FIT_XY_F32(super_critical_mine_C_working_face_corner)
+BATCH_FIT_XY_F32(super_critical_mine_C_startup_room_corner)
+BATCH_FIT_XY_F32(super_critical_mine_C_mid_panel_gateroad)
+
+#undef BATCH_F32_STEP
+#undef BATCH_FIT_X_F32
+#undef BATCH_FIT_XY_F32
+
+#undef BATCH_FITS
+#undef BATCH_TIER
+#undef BATCH_FIT_X
+#undef BATCH_FIT_XY
+#undef BATCH_KERNEL
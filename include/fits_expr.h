@@ -0,0 +1,274 @@
+/**
+ * @file fits_expr.h
+ *
+ * @brief Equation fits of all three mine models as expressions, shared by the
+ * scalar fits (fits.c) and the batched SIMD fits (fits_batch.c) so the MATLAB
+ * coefficients live in one place.
+ *
+ * Each macro evaluates to the unclamped fit. EXP and POW name the exp and pow
+ * implementations to use (pow is only ever called with a scalar exponent), and
+ * x/y may be doubles, floats or GCC vectors of either. K converts a
+ * coefficient to the element type (FIT_DOUBLE or FIT_FLOAT; GCC does not
+ * narrow a double constant to a float vector implicitly), pow exponents stay
+ * double. x and y must be plain variables: they are used unparenthesized and
+ * evaluated more than once.
+ */
+
+#ifndef GOB_FITS_EXPR_H
+#define GOB_FITS_EXPR_H
+
+/* coefficient conversions, the K argument of the expressions */
+#define FIT_DOUBLE(c) (c)
+#define FIT_FLOAT(c) ((float)(c))
+
+/*******************************************************************************
+ * TRONA MINE
+ * SUB CRITICAL PANEL
+*******************************************************************************/
+
+#define sub_critical_trona_working_face_corner_expr(K, EXP, POW, x, y)                               \
+	({                                                                                           \
+		/* factor expression in case compiler doesn't feel like doing it */                  \
+		const __typeof__(x) X_2 = x * x; /* x squared */                                     \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                                     \
+		const __typeof__(x) X_Y = x * y; /* x * y */                                         \
+                                                                                                     \
+		/* calculate change using coefficients from MATLAB */                                \
+		const __typeof__(x) VSI =                                                            \
+			POW(X_Y, 0.107302089705487) *                                                \
+			(K(0.1477) - K(0.812278751377339) * EXP(-K(9.96978304250904) * y) * X_Y +    \
+			 K(0.103507270969929) * EXP(-K(688.057090793680) * X_Y) -                    \
+			 K(0.1738) * EXP(-K(6.368) * y) + K(0.1971) * X_2 * EXP(-K(1.38) * X_2) +    \
+			 K(13.6) * Y_2 * EXP(-2890 * y) - K(14.56) * x * EXP(-K(47.01) * x) +        \
+			 K(11.19) * x * EXP(-7883 * X_2) + K(0.07992) * EXP(-K(2.155) * x) -         \
+			 K(6.274) * y * EXP(-K(99.58) * y) + K(0.03141) * y * EXP(-K(8.748) * Y_2)); \
+		VSI;                                                                                 \
+	})
+
+#define sub_critical_trona_mid_panel_gateroad_expr(K, EXP, POW, x)                        \
+	({                                                                                \
+		/* factor expression in case compiler doesn't feel like doing it */       \
+		const __typeof__(x) X_2 = x * x; /* x squared */                          \
+                                                                                          \
+		/* calculate change using coefficients from MATLAB */                     \
+		const __typeof__(x) VSI =                                                 \
+			K(0.2031) + K(0.007304) * x + K(1.495) * x * EXP(-K(19.69) * x) - \
+			K(0.1661) * EXP(-K(162.6) * X_2) -                                \
+			K(0.1315) * x * EXP(-K(7.204) * X_2) -                            \
+			K(3.298) * X_2 * EXP(-K(44.01) * X_2);                            \
+		VSI;                                                                      \
+	})
+
+#define sub_critical_trona_startup_room_corner_expr(K, EXP, POW, x, y)                            \
+	({                                                                                        \
+		/* factor expression in case compiler doesn't feel like doing it */               \
+		const __typeof__(x) X_Y = x * y; /* x * y */                                      \
+                                                                                                  \
+		/* calculate change using coefficients from MATLAB */                             \
+		const __typeof__(x) VSI =                                                         \
+			POW(X_Y, 0.1007) *                                                        \
+			(K(0.1796) + K(0.2762) * EXP(-K(4.552) * y) * X_Y +                       \
+			 K(0.04375) * EXP(-K(5.354) * X_Y) - K(0.3093) * EXP(-K(60.54) * x) -     \
+			 K(0.2702) * EXP(-K(50.36) * y) + K(0.437) * x * x * EXP(-K(2.728) * x)); \
+		VSI;                                                                              \
+	})
+
+/*******************************************************************************
+ * MINE E
+ * SUPER CRITICAL PANEL
+*******************************************************************************/
+
+#define super_critical_mine_E_startup_room_center_expr(K, EXP, POW, x, y)           \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.155394214) + x * x * (-K(0.004966014)) +                \
+			K(0.142894504) * y * EXP(-K(1.11507158) * Y_2) -            \
+			K(0.154156852) * EXP(-K(994.6190264) * Y_2) -               \
+			K(0.165429282) * Y_2 * EXP(-K(2.119029131) * Y_2);          \
+		VSI;                                                                \
+	})
+
+#define super_critical_mine_E_mid_panel_center_expr(K, EXP, POW, x, y)               \
+	({                                                                           \
+		/* factor expression in case compiler doesn't feel like doing it */  \
+		const __typeof__(x) X_2 = x * x; /* x squared */                     \
+                                                                                     \
+		/* calculate change using coefficients from MATLAB */                \
+		const __typeof__(x) VSI =                                            \
+			K(0.182881808) + K(0.000219076) * y - K(0.001701901) * X_2 - \
+			K(0.003415753) * X_2 * x;                                    \
+		VSI;                                                                 \
+	})
+
+#define super_critical_mine_E_working_face_center_expr(K, EXP, POW, x, y)           \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.034705045) + x * x * (-K(0.007156676)) +                \
+			K(0.392853454) * y * EXP(-K(2.690847002) * Y_2) -           \
+			K(0.016570035) * EXP(-290 * Y_2) +                          \
+			K(0.206091545) * Y_2 * EXP(-K(0.513740978) * Y_2);          \
+		VSI;                                                                \
+	})
+
+#define super_critical_mine_E_startup_room_corner_expr(K, EXP, POW, x, y)                   \
+	({                                                                                  \
+		/* factor expression in case compiler doesn't feel like doing it */         \
+		const __typeof__(x) X_Y = x * y; /* x * y */                                \
+                                                                                            \
+		/* calculate change using coefficients from MATLAB */                       \
+		const __typeof__(x) VSI =                                                   \
+			POW(X_Y, 0.070680995) *                                             \
+			(K(0.162003881) + K(0.114056257) * EXP(-K(2.060750448) * y) * X_Y + \
+			 K(0.027309527) * EXP(-K(2.32002878) * X_Y) -                       \
+			 K(0.134663756) * EXP(-K(8.323851432) * x) -                        \
+			 K(0.263467643) * EXP(-K(50.02086538) * y) +                        \
+			 K(51.01309648) * x * x * EXP(-K(24.66420708) * x));                \
+		VSI;                                                                        \
+	})
+
+#define super_critical_mine_E_mid_panel_gateroad_expr(K, EXP, POW, x, y)            \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) X_2 = x * x; /* x squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.10083973) + K(0.05329973) * x + K(0.000111875) * y +    \
+			K(0.715710581) * x * EXP(-K(3.193027724) * x) -             \
+			K(0.100070375) * EXP(-K(1200.384929) * X_2) -               \
+			K(0.151653961) * x * EXP(-K(3.716593738) * X_2) -           \
+			K(0.378856069) * X_2 * EXP(-K(16.20732696) * X_2);          \
+		VSI;                                                                \
+	})
+
+#define super_critical_mine_E_working_face_corner_expr(K, EXP, POW, x, y)                   \
+	({                                                                                  \
+		/* factor expression in case compiler doesn't feel like doing it */         \
+		const __typeof__(x) X_2 = x * x; /* x squared */                            \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                            \
+		const __typeof__(x) X_Y = x * y; /* x * y */                                \
+                                                                                            \
+		/* calculate change using coefficients from MATLAB */                       \
+		const __typeof__(x) VSI =                                                   \
+			POW(X_Y, 0.251307505) *                                             \
+			(K(0.197539477) - K(0.258183405) * EXP(-K(2.062155525) * y) * X_Y + \
+			 K(0.02301539) * EXP(-K(21.41498958) * X_Y) -                       \
+			 K(0.15928258) * EXP(-K(10.01527015) * y) +                         \
+			 K(0.445654501) * X_2 * EXP(-K(17.13983263) * X_2) +                \
+			 K(4.68818221) * Y_2 * EXP(-K(5.633256844) * y) -                   \
+			 K(13.90840849) * x * EXP(-K(65.9273908) * x) +                     \
+			 K(0.772026679) * x * EXP(-K(68.99785585) * X_2) +                  \
+			 K(34.5) * EXP(-K(3200.000001) * x) +                               \
+			 K(0.263621861) * y * EXP(-K(27.16257242) * y) -                    \
+			 K(0.255066042) * y * EXP(-K(9.010678902) * Y_2));                  \
+		VSI;                                                                        \
+	})
+
+/*******************************************************************************
+ * MINE C
+ * SUPER CRITICAL PANEL
+*******************************************************************************/
+
+#define super_critical_mine_C_startup_room_center_expr(K, EXP, POW, x, y)           \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.23446547) + x * x * (-K(0.007274502)) +                 \
+			K(0.21112871) * y * EXP(-K(1.254341353) * Y_2) -            \
+			K(0.232563013) * EXP(-K(986.7723584) * Y_2) -               \
+			K(0.288213205) * Y_2 * EXP(-K(2.41029839) * Y_2);           \
+		VSI;                                                                \
+	})
+
+#define super_critical_mine_C_mid_panel_center_expr(K, EXP, POW, x, y)              \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) X_2 = x * x; /* x squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.26928324) + K(0.000607666) * y - K(0.001387445) * X_2 - \
+			K(0.005923021406) * X_2 * x;                                \
+		VSI;                                                                \
+	})
+
+#define super_critical_mine_C_working_face_center_expr(K, EXP, POW, x, y)           \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.054623275) + x * x * (-K(0.007156676)) +                \
+			K(0.537305093) * y * EXP(-K(3.725760322) * Y_2) -           \
+			K(0.028010127) * EXP(-290 * Y_2) +                          \
+			K(0.501978887) * Y_2 * EXP(-K(0.911642577) * Y_2);          \
+		VSI;                                                                \
+	})
+
+#define super_critical_mine_C_working_face_corner_expr(K, EXP, POW, x, y)                         \
+	({                                                                                        \
+		/* factor expression in case compiler doesn't feel like doing it */               \
+		const __typeof__(x) X_2 = x * x; /* x squared */                                  \
+		const __typeof__(x) Y_2 = y * y; /* y squared */                                  \
+		const __typeof__(x) X_Y = x * y; /* x * y */                                      \
+                                                                                                  \
+		/* calculate change using coefficients from MATLAB */                             \
+		const __typeof__(x) VSI =                                                         \
+			POW(X_Y, 0.162024335) *                                                   \
+			(K(0.262664371) - K(0.253166473007042) * EXP(-K(3.203358282) * y) * X_Y + \
+			 K(0.065491826) * EXP(-K(228.3897538) * X_Y) -                            \
+			 K(0.243491669) * EXP(-K(8.890275525) * y) -                              \
+			 K(0.01) * X_2 * EXP(-K(47.29743004) * X_2) +                             \
+			 K(5.007983398) * Y_2 * EXP(-K(5.70033048) * y) -                         \
+			 K(27.10582475) * x * EXP(-K(73.60496053) * x) +                          \
+			 K(0.315580701) * x * EXP(-K(51.89579568) * X_2) +                        \
+			 K(38.98661392) * EXP(-K(3169.255209) * x) +                              \
+			 K(2.089424053) * y * EXP(-K(30.00980383) * y) -                          \
+			 K(0.303675247) * y * EXP(-K(7.38256233) * Y_2));                         \
+		VSI;                                                                              \
+	})
+
+#define super_critical_mine_C_startup_room_corner_expr(K, EXP, POW, x, y)                   \
+	({                                                                                  \
+		/* factor expression in case compiler doesn't feel like doing it */         \
+		const __typeof__(x) X_Y = x * y; /* x * y */                                \
+                                                                                            \
+		/* calculate change using coefficients from MATLAB */                       \
+		const __typeof__(x) VSI =                                                   \
+			POW(X_Y, 0.072583782) *                                             \
+			(K(0.222803703) + K(0.217897624) * EXP(-K(3.019723703) * y) * X_Y + \
+			 K(0.035000529) * EXP(-K(4.519932999) * X_Y) -                      \
+			 K(0.213737696) * EXP(-K(33.3990023) * x) -                         \
+			 K(0.399728137) * EXP(-K(49.33761923) * y) +                        \
+			 K(0.36279155) * x * x * EXP(-K(2.519206805) * x));                 \
+		VSI;                                                                        \
+	})
+
+#define super_critical_mine_C_mid_panel_gateroad_expr(K, EXP, POW, x, y)            \
+	({                                                                          \
+		/* factor expression in case compiler doesn't feel like doing it */ \
+		const __typeof__(x) X_2 = x * x; /* x squared */                    \
+                                                                                    \
+		/* calculate change using coefficients from MATLAB */               \
+		const __typeof__(x) VSI =                                           \
+			K(0.10083973) + K(0.128284224) * x + K(0.000603995) * y +   \
+			K(2.171935712) * x * EXP(-K(4.062177714) * x) -             \
+			K(0.101220528) * EXP(-K(1464.235434) * X_2) -               \
+			K(0.474820214) * x * EXP(-K(5.389192365) * X_2) -           \
+			K(1.477162806) * X_2 * EXP(-K(23.91528913) * X_2);          \
+		VSI;                                                                \
+	})
+
+#endif // GOB_FITS_EXPR_H
@@ -0,0 +1,135 @@
+/**
+ * @file flammability.h
+ *
+ * @brief Explosive gas zone classes of multi-component gas mixtures, from
+ * flammability limit polygons read from a data file (see flammability.dat).
+ *
+ * The fuels are combined with Le Chatelier's mixing rule into one equivalent
+ * fuel with the reference lower flammability limit (LFL):
+ *
+ *	x_eq = LFL_ref * sum(x_i / LFL_i)
+ *
+ * So a mixture sits at its flammability limit exactly when x_eq sits at the
+ * reference fuel's limit. Regions are polygons over (x_eq, x_O2) mole
+ * fractions, tested in file order (first match wins). Both coordinates are
+ * linear in the species mass fractions divided by the moles per gram, so a
+ * cell needs only three dot products over its species. They are then
+ * rasterized like the built-in diagram (egz.h): grid cells no polygon edge
+ * comes near store their class, and all others fall back to the exact
+ * point-in-polygon tests.
+ */
+
+#ifndef GOB_FLAMMABILITY_H
+#define GOB_FLAMMABILITY_H
+
+#include <stdbool.h>
+
+#include "udf.h" // Fluent macros, real typedef
+
+#include "egz.h" // for enum egz_class, EGZ_BOUNDARY
+
+#define FLAM_MAX_SPECIES 8
+#define FLAM_MAX_REGIONS 16
+#define FLAM_MAX_VERTICES 16
+
+/* lookup table cells along each mole fraction axis */
+#define FLAM_LUT_N 256
+
+/* one limit polygon and the class of the mixtures inside it */
+struct flam_region {
+	int egz_class;
+	int n; // vertices
+	double x[FLAM_MAX_VERTICES]; // equivalent fuel mole fraction
+	double y[FLAM_MAX_VERTICES]; // oxygen mole fraction
+};
+
+struct flam_table {
+	bool active; // a data file was loaded; otherwise the built-in diagram applies
+
+	/* per species: index into C_YI and mass fraction coefficients */
+	int n_species;
+	int species[FLAM_MAX_SPECIES];
+	double fuel_coef[FLAM_MAX_SPECIES]; // LFL_ref / (LFL * molar mass) for fuels
+	double oxygen_coef[FLAM_MAX_SPECIES]; // 1 / molar mass for oxygen
+	double moles_coef[FLAM_MAX_SPECIES]; // 1 / molar mass - 1 / balance molar mass
+	double moles_base; // 1 / balance molar mass
+
+	int n_regions;
+	struct flam_region regions[FLAM_MAX_REGIONS];
+	int default_class; // class outside every region
+
+	unsigned char lut[FLAM_LUT_N][FLAM_LUT_N];
+};
+
+/* table in use by calc_explosive_mix, loaded by udf_main */
+extern struct flam_table gob_flammability;
+
+/**
+ * @brief Loads and compiles the data file named by longwallgobs/flammability_file.
+ * The host reads the file and broadcasts its contents, so this must be called
+ * on the host and every node. An empty file name, or a file that fails to
+ * parse (reported to the console), leaves the table inactive.
+ *
+ * @param [out] table compiled table
+ */
+void flam_load(struct flam_table *table);
+
+/**
+ * @brief Classifies a point by testing the region polygons in order.
+ *
+ * @param [in] table compiled table
+ * @param [in] x_eq equivalent fuel mole fraction
+ * @param [in] x_O2 oxygen mole fraction
+ * @return [int] enum egz_class
+ */
+int flam_classify_exact(const struct flam_table *table, const double x_eq, const double x_O2);
+
+/**
+ * @brief Classifies a point from the lookup table, falling back to
+ * flam_classify_exact near the polygon edges. Same result as
+ * flam_classify_exact.
+ *
+ * @param [in] table compiled table
+ * @param [in] x_eq equivalent fuel mole fraction
+ * @param [in] x_O2 oxygen mole fraction
+ * @return [int] enum egz_class
+ */
+static inline int flam_classify(const struct flam_table *table, const double x_eq, const double x_O2)
+{
+	// also rejects NaN
+	if (x_eq >= 0 && x_eq < 1 && x_O2 >= 0 && x_O2 < 1) {
+		const int CODE = table->lut[(int)(x_O2 * FLAM_LUT_N)][(int)(x_eq * FLAM_LUT_N)];
+
+		if (CODE != EGZ_BOUNDARY)
+			return CODE;
+	}
+
+	return flam_classify_exact(table, x_eq, x_O2);
+}
+
+/**
+ * @brief Classifies the gas mixture of one cell.
+ *
+ * @param [in] table compiled (active) table
+ * @param [in] c cell
+ * @param [in] t cell thread
+ * @return [int] enum egz_class
+ */
+static inline int flam_classify_cell(const struct flam_table *table, const cell_t c, Thread *t)
+{
+	double fuel = 0;
+	double oxygen = 0;
+	double moles = table->moles_base;
+
+	for (int k = 0; k < table->n_species; ++k) {
+		const double Y = C_YI(c, t, table->species[k]);
+
+		fuel += table->fuel_coef[k] * Y;
+		oxygen += table->oxygen_coef[k] * Y;
+		moles += table->moles_coef[k] * Y;
+	}
+
+	return flam_classify(table, fuel / moles, oxygen / moles);
+}
+
+#endif // GOB_FLAMMABILITY_H
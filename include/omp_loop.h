@@ -0,0 +1,44 @@
+/**
+ * @file omp_loop.h
+ *
+ * @brief Optional OpenMP split of the cell loops within each compute node.
+ *
+ * begin_c_loop_omp/end_c_loop_omp are drop-in replacements for
+ * begin_c_loop/end_c_loop for loops whose cells are independent (no
+ * reductions, no writes to shared state other than the cell's own UDMs). The
+ * cell range is split across gob_omp_threads threads with static chunking,
+ * so every cell is computed exactly as in the serial loop and results are
+ * bit-identical. Without OpenMP (compiled without -fopenmp) or with
+ * gob_omp_threads <= 1 they are plain serial loops.
+ */
+
+#ifndef GOB_OMP_LOOP_H
+#define GOB_OMP_LOOP_H
+
+#include "udf.h" // Fluent macros
+
+/* OpenMP threads per compute node, set by udf_main from longwallgobs/omp_threads */
+extern int gob_omp_threads;
+
+#ifdef _OPENMP
+
+#define GOB_PRAGMA(x) _Pragma(#x)
+
+#define begin_c_loop_omp(c, t)                                                            \
+	{                                                                                 \
+		const int OMP_N_CELLS = THREAD_N_ELEMENTS(t);                             \
+                                                                                          \
+		GOB_PRAGMA(omp parallel for schedule(static) num_threads(gob_omp_threads) \
+			   if (gob_omp_threads > 1))                                      \
+		for (c = 0; c < OMP_N_CELLS; ++c)
+
+#define end_c_loop_omp(c, t) }
+
+#else
+
+#define begin_c_loop_omp(c, t) begin_c_loop(c, t)
+#define end_c_loop_omp(c, t) end_c_loop(c, t)
+
+#endif // _OPENMP
+
+#endif // GOB_OMP_LOOP_H
@@ -0,0 +1,38 @@
+/**
+ * @file panel_descriptor.h
+ *
+ * @brief Layout of the panel descriptor: the bounding boxes of the selected
+ * cell zones as Fluent reported them. parser.cpp writes it from a combined
+ * bounds report and the UDF loads it in place of the
+ * longwallgobs/<role>_{min,max}_{x,y} RP variables (see params.c). Plain C
+ * without udf.h, so both sides share it. The file, in the byte order of the
+ * machine that wrote it:
+ *
+ *	char magic[8]			GOB_PANEL_MAGIC
+ *	uint32_t version		GOB_PANEL_VERSION
+ *	uint32_t n_zones		GOB_PANEL_N_ZONES
+ *	struct gob_panel_zone[n_zones]	one per role, in enum gob_role order
+ */
+
+#ifndef GOB_PANEL_DESCRIPTOR_H
+#define GOB_PANEL_DESCRIPTOR_H
+
+#include <stdint.h>
+
+/* file name parser.cpp writes */
+#define GOB_PANEL_FILE "longwallgobs-panel.bin"
+
+#define GOB_PANEL_MAGIC "GOBPANEL"
+#define GOB_PANEL_VERSION 1u
+
+/* roles per descriptor, GOB_N_ROLES */
+#define GOB_PANEL_N_ZONES 7
+
+struct gob_panel_zone {
+	int32_t zone_id; // cell zone the bounds were measured on, -1 = role not selected
+	int32_t reserved; // 0
+	double min_x, max_x;
+	double min_y, max_y;
+};
+
+#endif // GOB_PANEL_DESCRIPTOR_H
@@ -0,0 +1,64 @@
+/**
+ * @file panel_frame.h
+ *
+ * @brief Panel frame: maps mesh coordinates to the coordinates the VSI fits
+ * are written in. The panel axes may be rotated by any angle about z from
+ * the mesh axes (longwallgobs/panel_angle); the zone bounds, and so the panel
+ * offsets and zone layouts, are measured along the panel axes. In panel
+ * coordinates x_loc is the distance from the panel center line (mirrored)
+ * and y_loc the distance from the recovery room edge.
+ */
+
+#ifndef GOB_PANEL_FRAME_H
+#define GOB_PANEL_FRAME_H
+
+#include <stdint.h>
+
+#include "params.h" // for struct gob_params
+
+struct gob_panel_frame {
+	double cos_angle, sin_angle; // rotation of the panel axes
+	double x_offset, y_offset; // panel origin along the panel axes
+};
+
+/**
+ * @brief Frame of a parameter snapshot.
+ *
+ * @param [out] frame panel frame
+ * @param [in] params parameter snapshot (panel angle and offsets)
+ */
+void gob_panel_frame_of(struct gob_panel_frame *frame, const struct gob_params *params);
+
+/**
+ * @brief Rotates a mesh point onto the panel axes, without the offsets (what
+ * the zone bounds are measured in).
+ *
+ * @param [in] frame panel frame
+ * @param [in] x, y mesh coordinates (m)
+ * @param [out] u, v coordinates along the panel width and length (m)
+ */
+void gob_panel_frame_axes(const struct gob_panel_frame *frame, const double x, const double y, double *u,
+			  double *v);
+
+/**
+ * @brief Maps a mesh point to panel coordinates. With the panel axes along
+ * the mesh axes this is exactly fabs(x - x_offset), fabs(y - y_offset).
+ *
+ * @param [in] frame panel frame
+ * @param [in] x, y mesh coordinates (m)
+ * @param [out] x_loc distance from panel center line (m)
+ * @param [out] y_loc distance from recovery room edge (m)
+ */
+void gob_panel_frame_map(const struct gob_panel_frame *frame, const double x, const double y, double *x_loc,
+			 double *y_loc);
+
+/**
+ * @brief Hashes everything the panel coordinates of the cells depend on: the
+ * frame and the mesh shape.
+ *
+ * @param [in] params parameter snapshot
+ * @return [uint64_t] key of the panel coordinates (never 0)
+ */
+uint64_t gob_panel_frame_key(const struct gob_params *params);
+
+#endif // GOB_PANEL_FRAME_H
@@ -0,0 +1,132 @@
+/**
+ * @file params.h
+ *
+ * @brief Snapshot of every RP variable the VSI and gob property fields depend
+ * on, read once per udf_main execution. Comparing a snapshot with the one the
+ * current fields were computed from tells which fields are stale:
+ *
+ *	geometry (mine, mesh, frame, zones, raster,    -> VSI and everything below
+ *	fit precision, float32)
+ *	max_vsi                                        -> VSI clamp (udm-4) and below
+ *	max_porosity, initial_porosity                 -> porosity (udm-1) and below
+ *	resistance settings                            -> resistances (udm-0, udm-5)
+ *
+ * In parallel only the host reads the RP variables and broadcasts them to the
+ * compute nodes in a single message.
+ */
+
+#ifndef GOB_PARAMS_H
+#define GOB_PARAMS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "udf.h" // Fluent macros, real typedef
+
+/* bounding box of one selected zone, from the GUI */
+struct gob_zone_bounds {
+	real min_x, max_x;
+	real min_y, max_y;
+};
+
+struct gob_params {
+	/* geometry */
+	bool mine_c, mine_e, mine_t;
+	bool single_part_mesh; // a zone is assigned to "Single Part Mesh"
+	real panel_angle; // rotation of the panel axes from the mesh axes (radians, about z)
+	real panel_x_offset; // displacement to center of old panel (along the panel axes)
+	real panel_y_offset; // displacement to recovery room of old panel (along the panel axes)
+	struct gob_zone_bounds startup_room_center, startup_room_corner;
+	struct gob_zone_bounds mid_panel_center, mid_panel_gateroad;
+	struct gob_zone_bounds working_face_center, working_face_corner;
+	struct gob_zone_bounds single_part_mesh_bounds;
+	real vsi_raster_spacing; // 0 = evaluate every cell exactly
+	int fit_precision; // enum fits_precision of the batched fits
+	bool single_precision; // fits (as FITS_PRECISION_FLOAT32) and resistances in float32
+	uint64_t mesh_shape; // hash of the cell thread ids and sizes
+
+	/* VSI clamp */
+	real max_vsi; // setting, or the default of the selected mine
+
+	/* porosity */
+	real max_porosity;
+	real initial_porosity; // porosity scaler
+
+	/* resistances */
+	real resist_scaler;
+	real max_resistance, min_resistance;
+	real max_inertial_resistance, min_inertial_resistance;
+	real reference_porosity; // porosity of the unstrained rock, for Initial_Perm
+};
+
+/* parts of the panel the GUI assigns a cell zone to */
+enum gob_role {
+	GOB_STARTUP_ROOM_CENTER,
+	GOB_STARTUP_ROOM_CORNER,
+	GOB_MID_PANEL_CENTER,
+	GOB_MID_PANEL_GATEROAD,
+	GOB_WORKING_FACE_CENTER,
+	GOB_WORKING_FACE_CORNER,
+	GOB_SINGLE_PART_MESH,
+	GOB_N_ROLES
+};
+
+/* role names as used in the RP variables (longwallgobs/<name>_id, ...) */
+extern const char *const GOB_ROLE_NAMES[GOB_N_ROLES];
+
+/* run settings that do not change any field value */
+struct gob_options {
+	bool cache_fields; // save/load the fields to/from the cache file(s)
+	bool explosive_mix; // compute the explosive gas zones (udm-2, udm-3)
+	int omp_threads; // OpenMP threads per compute node
+	int egz_max_interval; // longest gap between explosive gas zone updates (iterations/timesteps)
+	real egz_tolerance; // relative explosive volume change below which updates are spread out
+	int zone_ids[GOB_N_ROLES]; // cell zone assigned to each role (-1 = none)
+};
+
+/* which fields a parameter change makes stale, see gob_params_diff */
+#define GOB_PARAMS_GEOMETRY 0x1u
+#define GOB_PARAMS_CLAMP 0x2u
+#define GOB_PARAMS_POROSITY 0x4u
+#define GOB_PARAMS_RESISTANCE 0x8u
+#define GOB_PARAMS_ALL 0xfu
+
+/**
+ * @brief Reads every parameter from the RP variables (or their defaults). In
+ * parallel the host reads them and broadcasts them to the nodes, so this must
+ * be called on the host and every node.
+ *
+ * @param [out] params snapshot (mesh_shape is left 0 on the host)
+ * @param [out] options run settings
+ * @param [in] d domain holding the gob cell threads
+ */
+void gob_params_load(struct gob_params *params, struct gob_options *options, Domain *d);
+
+/**
+ * @brief Hashes the cell thread ids and sizes of this process, which
+ * re-meshing or adapting the domain changes. Node only.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @return [uint64_t] mesh_shape of a snapshot loaded now
+ */
+uint64_t gob_mesh_shape(Domain *d);
+
+/**
+ * @brief Compares two snapshots.
+ *
+ * @param [in] previous parameters the current fields were computed from
+ * @param [in] current freshly loaded parameters
+ * @return [unsigned] GOB_PARAMS_* bits of the stale fields, each bit already
+ * including the ones downstream of it (0 if nothing changed)
+ */
+unsigned gob_params_diff(const struct gob_params *previous, const struct gob_params *current);
+
+/**
+ * @brief Hashes a snapshot, for keying stored fields.
+ *
+ * @param [in] params snapshot
+ * @return [uint64_t] hash of every parameter
+ */
+uint64_t gob_params_hash(const struct gob_params *params);
+
+#endif // GOB_PARAMS_H
@@ -0,0 +1,127 @@
+/**
+ * @file properties.h
+ *
+ * @brief Gob properties of one cell from its VSI: porosity, then the viscous
+ * (Carmen-Kozeny) and inertial (Blake-Kozeny) resistances from the porosity,
+ * each limited to its configured range and scaled. Used by
+ * calc_gob_properties, the property sweep and the offline evaluator
+ * (tools/offline).
+ */
+
+#ifndef GOB_PROPERTIES_H
+#define GOB_PROPERTIES_H
+
+#include "params.h" // for struct gob_params
+#include "utils.h" // for clamp_positive, Cell_Resistance, ...
+
+/* property settings, with the reference permeability/inertia worked out once */
+struct gob_property_model {
+	real max_porosity; // V_v, maximum gob porosity
+	real initial_porosity; // a, porosity scaler
+	real resist_scaler;
+	real max_resistance, min_resistance;
+	real max_inertial_resistance, min_inertial_resistance;
+	real initial_permeability;
+	real initial_inertia_resistance;
+	bool single_precision; // resistances in float32
+};
+
+/**
+ * @brief Prepares the property settings of a parameter snapshot.
+ *
+ * @param [out] model property settings
+ * @param [in] params parameter snapshot (porosity and resistance settings)
+ */
+void gob_property_model_init(struct gob_property_model *model, const struct gob_params *params);
+
+/**
+ * @brief Porosity from the VSI: n = (V_v - VSI) * a, limited to zero. Takes
+ * the settings as values, so the property sweep can vary them per variant.
+ *
+ * @param [in] vsi clamped volumetric strain increment
+ * @param [in] max_porosity V_v, maximum gob porosity
+ * @param [in] initial_porosity a, porosity scaler
+ * @return [real] porosity
+ */
+static inline real gob_porosity_of(const real vsi, const real max_porosity, const real initial_porosity)
+{
+	return clamp_positive((max_porosity - vsi) * initial_porosity);
+}
+
+/**
+ * @brief Porosity from the VSI with the settings of a model, see
+ * gob_porosity_of.
+ *
+ * @param [in] model property settings
+ * @param [in] vsi clamped volumetric strain increment
+ * @return [real] porosity
+ */
+static inline real gob_porosity(const struct gob_property_model *model, const real vsi)
+{
+	return gob_porosity_of(vsi, model->max_porosity, model->initial_porosity);
+}
+
+/**
+ * @brief Viscous and inertial resistance from the porosity, with the
+ * reference values, limits and precision of a model and the given scaler
+ * (which the property sweep varies per variant).
+ *
+ * @param [in] model property settings (resist_scaler goes unused)
+ * @param [in] porosity cell porosity
+ * @param [in] resist_scaler scaler applied to both resistances
+ * @param [out] viscous scaled viscous resistance (1/m^2)
+ * @param [out] inertial scaled inertial resistance (1/m)
+ */
+static inline void gob_resistances_scaled(const struct gob_property_model *model, const real porosity,
+					  const real resist_scaler, real *viscous, real *inertial)
+{
+	real cellresist, cellinertiaresist;
+
+	if (model->single_precision) {
+		/* Carmen-Kozeny and Blake-Kozeny in float32, out-of-range values are limited below */
+		cellresist = Cell_Resistance_f32((float)porosity, (float)model->initial_permeability);
+		cellinertiaresist = Cell_Inertia_Resistance_f32((float)porosity, (float)model->initial_inertia_resistance);
+	} else {
+		/* Carmen-Kozeny Relationship */
+		cellresist = Cell_Resistance(porosity, model->initial_permeability);
+
+		/* Blake-Kozeny Relationship */
+		cellinertiaresist = Cell_Inertia_Resistance(porosity, model->initial_inertia_resistance);
+	}
+
+	/* Limit MAX and MIN resistance */
+	if (cellresist < model->max_resistance) {
+		if (cellresist < model->min_resistance)
+			cellresist = model->min_resistance;
+	} else {
+		cellresist = model->max_resistance;
+	}
+
+	if (cellinertiaresist < model->max_inertial_resistance) {
+		if (cellinertiaresist < model->min_inertial_resistance)
+			cellinertiaresist = model->min_inertial_resistance;
+	} else {
+		cellinertiaresist = model->max_inertial_resistance;
+	}
+
+	/* Scaler applied to cell resistances */
+	*viscous = cellresist * resist_scaler;
+	*inertial = cellinertiaresist * resist_scaler;
+}
+
+/**
+ * @brief Viscous and inertial resistance from the porosity with the settings
+ * of a model, see gob_resistances_scaled.
+ *
+ * @param [in] model property settings
+ * @param [in] porosity cell porosity
+ * @param [out] viscous scaled viscous resistance (1/m^2)
+ * @param [out] inertial scaled inertial resistance (1/m)
+ */
+static inline void gob_resistances(const struct gob_property_model *model, const real porosity, real *viscous,
+				   real *inertial)
+{
+	gob_resistances_scaled(model, porosity, model->resist_scaler, viscous, inertial);
+}
+
+#endif // GOB_PROPERTIES_H
@@ -0,0 +1,40 @@
+/**
+ * @file property_export.h
+ *
+ * @brief Static property export: the porosity and resistance fields written
+ * once as a Fluent point profile file (longwallgobs-properties.prof), so the
+ * gob zones can take them as fixed cell zone properties instead of calling
+ * the profile UDFs, which copy the UDMs into the solver every iteration.
+ *
+ * Each selected zone gets its own profile "gob-<zone id>", so values are never
+ * interpolated across zones. The points are the cell centroids, with the
+ * fields
+ *	x, y[, z], porosity (udm-1), viscous-resistance (udm-0),
+ *	inertial-resistance (udm-5)
+ * The three directions of each resistance share one field, as they share one
+ * UDM.
+ */
+
+#ifndef GOB_PROPERTY_EXPORT_H
+#define GOB_PROPERTY_EXPORT_H
+
+#include <stdbool.h>
+
+#include "udf.h" // Fluent macros
+
+#include "params.h" // for struct gob_options
+
+#define GOB_PROPERTY_FILE "longwallgobs-properties.prof"
+
+/**
+ * @brief Writes the profile file. Node only; every node must call it since
+ * node zero gathers the cells of the others, one field of one zone at a time
+ * in fixed-size chunks, and writes them.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] options zones the fields were computed for
+ * @return [true] file written (always true on nodes other than zero)
+ */
+bool gob_properties_export(Domain *d, const struct gob_options *options);
+
+#endif // GOB_PROPERTY_EXPORT_H
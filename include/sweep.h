@@ -0,0 +1,73 @@
+/**
+ * @file sweep.h
+ *
+ * @brief Property sweep: the porosity and both resistances of every cell for
+ * several variants of the porosity settings at once, from the VSI already in
+ * the UDMs, without touching the gob fields themselves.
+ *
+ * The variants come from a sweep file (longwallgobs/sweep_file), one per
+ * line, '#' starts a comment:
+ *	variant [max_vsi=<value>] [max_porosity=<value>] [initial_porosity=<value>] [resist_scaler=<value>]
+ * Settings a variant leaves out keep the values the fields were computed
+ * with. The resistance limits are shared by all variants.
+ *
+ * One pass over the cells re-clamps the raw VSI (udm-6) and evaluates every
+ * variant per cell with the property formulas of properties.h; the settings
+ * are stored one array per setting, so that inner loop runs over contiguous
+ * variants. Results go to
+ * longwallgobs-sweep.csv (per variant, reduced over the nodes: volume-weighted
+ * mean, min and max of each field and the explosive volume) and to a field
+ * file per node, see gob_sweep_run.
+ */
+
+#ifndef GOB_SWEEP_H
+#define GOB_SWEEP_H
+
+#include <stdbool.h>
+
+#include "udf.h" // Fluent macros, real typedef
+
+#include "params.h" // for struct gob_params
+
+/* variants per sweep */
+#define GOB_SWEEP_MAX 16
+
+/* the variants' settings, NAN where a variant keeps the computed value */
+struct gob_sweep {
+	int n;
+	real max_vsi[GOB_SWEEP_MAX];
+	real max_porosity[GOB_SWEEP_MAX];
+	real initial_porosity[GOB_SWEEP_MAX];
+	real resist_scaler[GOB_SWEEP_MAX];
+};
+
+/**
+ * @brief Reads the sweep file on the host and broadcasts the variants; every
+ * process must call it.
+ *
+ * @param [out] sweep variants (n = 0 without a usable file)
+ * @return [true] at least one variant
+ */
+bool gob_sweep_load(struct gob_sweep *sweep);
+
+/**
+ * @brief Evaluates every variant over the domain and writes the results.
+ * Node only; every node must call it since it reduces across nodes (node
+ * zero writes longwallgobs-sweep.csv). Each node writes its own cells to
+ * longwallgobs-sweep-<node>.fields (longwallgobs-sweep.fields in serial):
+ * the "GOBSWEEP" magic, then as uint32 the size of a real, the variant and
+ * the thread count; per thread its int32 id and cell count, then per cell
+ * the porosity of every variant, then their viscous and then their inertial
+ * resistances (3 x variants reals).
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] sweep variants
+ * @param [in] params parameters the fields were computed from (for the
+ * settings the variants leave out and the resistance limits)
+ * @param [in] explosive_mix the EGZ classes (udm-7) are up to date
+ * @return [true] files written
+ */
+bool gob_sweep_run(Domain *d, const struct gob_sweep *sweep, const struct gob_params *params,
+		   const bool explosive_mix);
+
+#endif // GOB_SWEEP_H
@@ -0,0 +1,30 @@
+/**
+ * @file totals.h
+ *
+ * @brief Domain-wide totals of the gob fields. Each compute node sums its
+ * interior cells only (exterior cells are copies of another node's interior
+ * cells) and the node results are combined with global reductions, so the
+ * totals are the same on every node and for any partitioning.
+ */
+
+#ifndef GOB_TOTALS_H
+#define GOB_TOTALS_H
+
+#include "udf.h" // Fluent macros, real typedef
+
+struct gob_totals {
+	int n_cells; // cells in the domain
+	real volume; // total cell volume (m^3)
+	real min_vsi, max_vsi; // range of the clamped VSI (udm-4)
+};
+
+/**
+ * @brief Sums the fields over the whole domain. Node only; every node must
+ * call it since it ends in global reductions.
+ *
+ * @param [out] totals domain-wide totals
+ * @param [in] d domain holding the gob cell threads
+ */
+void gob_totals_compute(struct gob_totals *totals, Domain *d);
+
+#endif // GOB_TOTALS_H
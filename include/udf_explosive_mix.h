@@ -3,7 +3,9 @@
 
 #include "udf.h" // Fluent macros
 
-#include "utils.h" // for fequal
+#include "egz.h" // for egz_classify
+#include "flammability.h" // for flam_classify_cell
+#include "omp_loop.h" // for begin_c_loop_omp
 
 /*
 	!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -11,140 +13,62 @@
 	!!!!!!!EGZ!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!EGZ!!!!!!
 	!!!!!!!!!!!! STORES in (user-define-memory 2)   !!!!!!!!!!!!
 	!!!!!!!!!!!!!!!!!!!!!!          udm-2           !!!!!!!!!!!!
+	!!!!!!!!!!!! and the explosive marker in udm-3  !!!!!!!!!!!!
+	!!!!!!!!!!!! udm-7 holds the class (egz.h)      !!!!!!!!!!!!
 	!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 */
 
-#define calc_explosive_mix()                                                                                \
-	({                                                                                                  \
-		Domain *d;                                                                                  \
-		Thread *t;                                                                                  \
-		cell_t c;                                                                                   \
-                                                                                                            \
-		real px;                                                                                    \
-		real py;                                                                                    \
-		real u;                                                                                     \
-		real v;                                                                                     \
-		real u1;                                                                                    \
-		real v1;                                                                                    \
-		real w;                                                                                     \
-		real Y_CH4, Y_O2, Y_N2, MW_CH4, MW_O2, MW_N2, MW_Mix, X_CH4, X_O2;                          \
-		real explode;                                                                               \
-		d = Get_Domain(1);                                                                          \
-		thread_loop_c(t, d)                                                                         \
-		{                                                                                           \
-			begin_c_loop(c, t)                                                                  \
-			{                                                                                   \
-				/* Y_X = Mass Fraction of Species X  || X_X = Mole Fraction of Species X */ \
-				Y_CH4 = C_YI(c, t, 0);                                                      \
-				Y_O2 = C_YI(c, t, 1);                                                       \
-				Y_N2 = 1.0 - Y_CH4 - Y_O2;                                                  \
-				MW_CH4 = 16.043;                                                            \
-				MW_O2 = 31.9988;                                                            \
-				MW_N2 = 28.0134;                                                            \
-				MW_Mix = 1 / (Y_CH4 / MW_CH4 + Y_O2 / MW_O2 + Y_N2 / MW_N2);                \
-				X_CH4 = (Y_CH4 * MW_Mix) / MW_CH4; /* X = Mole Fraction of X */             \
-				X_O2 = (Y_O2 * MW_Mix) / MW_O2;                                             \
-				px = X_CH4;                                                                 \
-				py = X_O2;                                                                  \
-				u = 0.8529 * px + 0.0606; /* Near Explosive to Explosive Slope */           \
-				v = -0.21 * px + 0.21; /* Upper Explosive Limit  */                         \
-				u1 = 0.8864 * px + 0.0445; /* Near Explosive to Requires Air Slope */       \
-				v1 = -1.3929 * px + 0.195;                                                  \
-				w = v1;                                                                     \
-				/*v1=-1.2647*px+0.1771; Cyan to Yellow Slope Transition */                  \
-                                                                                                            \
-				/*w=-1.8545*px+0.2095; Continuation of Slope Oxygen Rich to Oxygen Poor */  \
-                                                                                                            \
-				/* Explosive Zone - RED */                                                  \
-				if (py > u && px > 0.055 && py < v) {                                       \
-					explode = 1.0E0;                                                    \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Near Explosive Zone - ORANGE */                                        \
-				else if (py > u1 && px > 0.04 && py < v) {                                  \
-					explode = 0.81E0;                                                   \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Fuel Rich Inert - YELLOW */                                            \
-				else if (py < u1 && py > v1 && px > 0.055) {                                \
-					explode = 0.66E0;                                                   \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Oxygen Lean Inert - Green A  */                                        \
-				else if (py < v1 && px > 0.04) {                                            \
-					explode = 0.48E0;                                                   \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Oxygen Lean Inert - DARK  GREEN  */                                    \
-				else if (py < 0.08 && px < 0.04) {                                          \
-					explode = 0.0E0;                                                    \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Oxygen Lean Inert - Green B  */                                        \
-				else if (py < w && px < 0.04) {                                             \
-					explode = 0.48E0;                                                   \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Oxygen Rich Inert - CYAN */                                            \
-				else if (py > w) {                                                          \
-					explode = 0.27E0;                                                   \
-					C_UDMI(c, t, 2) = explode;                                          \
-				} /* Explosive Zone - DARK BLUE */                                          \
-				else {                                                                      \
-					explode = 2.66E0;                                                   \
-					C_UDMI(c, t, 2) = explode;                                          \
-				}                                                                           \
-			}                                                                                   \
-			end_c_loop(c, t);                                                                   \
-		}                                                                                           \
-		void;                                                                                       \
-	})
-
 /*
 	_________________________________________
 	|                                       |
 	|   Explosive Intergral                 |
-	|   Must use Volume-Integral-report     |
+	|   Summed right after the update, no   |
+	|   Volume-Integral-report needed       |
 	|                                       |
 	|   STORES in (user-define-memory 3)    |
 	|            udm-3                      |
 	-----------------------------------------
-*/
 
-#define calc_explosive_integral_gob()                                                                                                                                                                                                                                                                                       \
-	/* For use in the gob - currently porosity in strata is user-defined-variable and this will return a value of zero in the strata because the value of the porosity stored in C_UDMI(c,t,1) is zero. This could be changed by patching a value into C_UDMI for the strata. For strata use: calc_explosive_integral*/ \
-	({                                                                                                                                                                                                                                                                                                                  \
-		Domain *d;                                                                                                                                                                                                                                                                                                  \
-		Thread *t;                                                                                                                                                                                                                                                                                                  \
-		cell_t c;                                                                                                                                                                                                                                                                                                   \
-		d = Get_Domain(1);                                                                                                                                                                                                                                                                                          \
-		thread_loop_c(t, d)                                                                                                                                                                                                                                                                                         \
-		{                                                                                                                                                                                                                                                                                                           \
-			begin_c_loop(c, t)                                                                                                                                                                                                                                                                                  \
-			{                                                                                                                                                                                                                                                                                                   \
-				if (fequal(C_UDMI(c, t, 2), 1)) {                                                                                                                                                                                                                                                           \
-					/* Assign marker value for cell volume that is explosive */                                                                                                                                                                                                                         \
-                                                                                                                                                                                                                                                                                                                            \
-					C_UDMI(c, t, 3) = 1 - C_UDMI(c, t, 1);                                                                                                                                                                                                                                              \
-				} /* Report Volume-Volume-Integral udm-3 */                                                                                                                                                                                                                                                 \
-                                                                                                                                                                                                                                                                                                                            \
-				/* Cell_Volume*Cell_Porosity*1.000e0 = The explosive volume reported */                                                                                                                                                                                                                     \
-			}                                                                                                                                                                                                                                                                                                   \
-			end_c_loop(c, t);                                                                                                                                                                                                                                                                                   \
-		}                                                                                                                                                                                                                                                                                                           \
-		void;                                                                                                                                                                                                                                                                                                       \
-	})
+	For use in the gob - currently porosity in strata is user-defined-variable and this will return a value of zero in the strata because the value of the porosity stored in C_UDMI(c,t,1) is zero. This could be changed by patching a value into C_UDMI for the strata.
+
+	Evaluates to this node's explosive volume (interior cells only); sum it over the nodes with PRF_GRSUM1.
+*/
 
-#define reset_explosive_integral()                                                                   \
-	({                                                                                           \
-		/* Required to execute on transient runs - otherwise explosive volume is additive */ \
-		Domain *d;                                                                           \
-		Thread *t;                                                                           \
-		cell_t c;                                                                            \
-		d = Get_Domain(1);                                                                   \
-		thread_loop_c(t, d)                                                                  \
-		{                                                                                    \
-			begin_c_loop(c, t)                                                           \
-			{                                                                            \
-				C_UDMI(c, t, 3) = 0.00E0;                                            \
-			}                                                                            \
-			end_c_loop(c, t);                                                            \
-		}                                                                                    \
-		void;                                                                                \
+#define calc_explosive_mix()                                                                                                              \
+	({                                                                                                                                \
+		Domain *d;                                                                                                                \
+		Thread *t;                                                                                                                \
+		cell_t c;                                                                                                                 \
+		real explosive_volume = 0;                                                                                                \
+                                                                                                                                          \
+		egz_lut_build();                                                                                                          \
+                                                                                                                                          \
+		d = Get_Domain(1);                                                                                                        \
+		thread_loop_c(t, d)                                                                                                       \
+		{                                                                                                                         \
+			begin_c_loop_omp(c, t)                                                                                            \
+			{                                                                                                                 \
+				/* limits from the data file, or the Coward diagram from the methane (0) and oxygen (1) mass fractions */ \
+				const int EGZ = gob_flammability.active ? flam_classify_cell(&gob_flammability, c, t) :                   \
+						egz_classify(C_YI(c, t, 0), C_YI(c, t, 1));                                               \
+                                                                                                                                          \
+				C_UDMI(c, t, 7) = EGZ;                                                                                    \
+				C_UDMI(c, t, 2) = EGZ_DISPLAY[EGZ];                                                                       \
+                                                                                                                                          \
+				/* Explosive marker (udm-3), cleared where the mixture is no longer explosive */                          \
+				C_UDMI(c, t, 3) = EGZ == EGZ_EXPLOSIVE ? 1 - C_UDMI(c, t, 1) : 0;                                         \
+			}                                                                                                                 \
+			end_c_loop_omp(c, t);                                                                                             \
+                                                                                                                                          \
+			/* Cell_Volume*marker = The explosive volume reported, summed serially in cell order so it does not               \
+			   depend on the thread count; exterior cells belong to another node */                                           \
+			begin_c_loop_int(c, t)                                                                                            \
+			{                                                                                                                 \
+				explosive_volume += C_VOLUME(c, t) * C_UDMI(c, t, 3);                                                     \
+			}                                                                                                                 \
+			end_c_loop_int(c, t);                                                                                             \
+		}                                                                                                                         \
+		explosive_volume;                                                                                                         \
 	})
 
 #endif // GOB_UDF_EXPLOSIVE_MIX_H
@@ -0,0 +1,73 @@
+#ifndef GOB_UDF_PROPERTIES_H
+#define GOB_UDF_PROPERTIES_H
+
+#include "udf.h" // Fluent macros
+
+#include "omp_loop.h" // for begin_c_loop_omp
+#include "params.h" // for struct gob_params
+#include "properties.h" // for gob_porosity, gob_resistances
+
+/*
+	-------------------------------------------------
+	!   Gob properties from the VSI (udm-4), one    !
+	!   sweep per cell thread                       !
+	!                                               !
+	!   STORES in (user-define-memory 0, 1 and 5)   !
+	!       udm-0 viscous resistance                !
+	!       udm-1 porosity                          !
+	!       udm-5 inertial resistance               !
+	!                                               !
+	!   The porosity, permeability and inertia      !
+	!   profiles only publish these slots           !
+	!-----------------------------------------------!
+*/
+
+/**
+ * @brief Recomputes the gob properties of every cell from the VSI.
+ *
+ * @param [in] params parameter snapshot (porosity and resistance settings)
+ * @param [in] update_porosity recompute porosity (udm-1) from the VSI, or
+ * only the resistances from the stored porosity
+ */
+#define calc_gob_properties(params, update_porosity)                                                                   \
+	({                                                                                                             \
+		struct gob_property_model model;                                                                       \
+		gob_property_model_init(&model, (params));                                                             \
+                                                                                                                       \
+		Domain *d = Get_Domain(1);                                                                             \
+		Thread *t;                                                                                             \
+		cell_t c;                                                                                              \
+                                                                                                                       \
+		thread_loop_c(t, d)                                                                                    \
+		{                                                                                                      \
+			begin_c_loop_omp(c, t)                                                                         \
+			{                                                                                              \
+				/* Initial Maximum gob porosity minus the change in porosity (VSI), limited to zero */ \
+				if (update_porosity)                                                                   \
+					C_UDMI(c, t, 1) = gob_porosity(&model, C_UDMI(c, t, 4));                       \
+                                                                                                                       \
+				real viscous, inertial;                                                                \
+				gob_resistances(&model, C_UDMI(c, t, 1), &viscous, &inertial);                         \
+                                                                                                                       \
+				C_UDMI(c, t, 0) = viscous;                                                             \
+				C_UDMI(c, t, 5) = inertial;                                                            \
+			}                                                                                              \
+			end_c_loop_omp(c, t);                                                                          \
+		}                                                                                                      \
+		void;                                                                                                  \
+	})
+
+/* copy one stored property slot into the profile of the current thread */
+#define publish_gob_property(udm)                                \
+	({                                                       \
+		cell_t c;                                        \
+                                                                 \
+		begin_c_loop_omp(c, t)                           \
+		{                                                \
+			C_PROFILE(c, t, nv) = C_UDMI(c, t, udm); \
+		}                                                \
+		end_c_loop_omp(c, t);                            \
+		void;                                            \
+	})
+
+#endif // GOB_UDF_PROPERTIES_H
@@ -22,8 +22,133 @@
 
 #include <stdbool.h>
 
-#include "fits.h" // for equation fits
+#include "fits_batch.h" // for fits_batch_set_precision
+#include "omp_loop.h" // for begin_c_loop_omp
+#include "panel_frame.h" // for struct gob_panel_frame
+#include "params.h" // for struct gob_params
 #include "utils.h" // for clamp
+#include "vsi_layout.h" // for the zone layouts
+#include "vsi_raster.h" // for tabulated VSI surfaces
+#include "vsi_stepped.h" // for per-point VSI surfaces
+
+/**
+ * @brief Maps every cell centroid into the panel frame: stores the distance
+ * from the panel center line in udm-8 and from the recovery room edge in
+ * udm-9. Depends only on the mesh and the frame (gob_panel_frame_key), so it
+ * runs once per mesh and frame, not once per VSI evaluation.
+ *
+ * @param [in] params parameter snapshot (panel angle and offsets)
+ */
+#define vsi_panel_coords(params)                                                             \
+	({                                                                                   \
+		struct gob_panel_frame frame;                                                \
+		gob_panel_frame_of(&frame, (params));                                        \
+                                                                                             \
+		Domain *d = Get_Domain(1);                                                   \
+		Thread *t;                                                                   \
+		cell_t c;                                                                    \
+                                                                                             \
+		thread_loop_c(t, d)                                                          \
+		{                                                                            \
+			begin_c_loop_omp(c, t)                                               \
+			{                                                                    \
+				real loc[ND_ND];                                             \
+				double x_loc, y_loc;                                         \
+				C_CENTROID(loc, c, t);                                       \
+                                                                                             \
+				gob_panel_frame_map(&frame, loc[0], loc[1], &x_loc, &y_loc); \
+				C_UDMI(c, t, 8) = x_loc;                                     \
+				C_UDMI(c, t, 9) = y_loc;                                     \
+			}                                                                    \
+			end_c_loop_omp(c, t);                                                \
+		}                                                                            \
+		void;                                                                        \
+	})
+
+/**
+ * @brief Evaluates a stepped VSI surface at every cell: stores the raw VSI in
+ * udm-6 and the VSI clamped to [0, max_vsi] in udm-4. Reads the panel
+ * coordinates vsi_panel_coords left in udm-8 and udm-9.
+ *
+ * @param [in] params parameter snapshot (zone bounds, max_vsi)
+ * @param [in] layout_fn zone layout builder of the mine model (vsi_*_layout)
+ */
+#define vsi_stepped_fields(params, layout_fn)                                                                            \
+	({                                                                                                               \
+		/*  retrieve RP variables from Fluent (or set default values) */                                         \
+                                                                                                                         \
+		const real max_vsi = (params)->max_vsi; /* maximum VSI to clamp output to */                             \
+                                                                                                                         \
+		/* zone layout from the selected zones (or the single part mesh) */                                      \
+		struct vsi_layout layout;                                                                                \
+		layout_fn(&layout, (params));                                                                            \
+                                                                                                                         \
+		/* accuracy tier of the batched fits, which also restarts the sampled error */                           \
+		fits_batch_set_precision((params)->fit_precision);                                                       \
+                                                                                                                         \
+		/* optionally tabulate the surface once and sample it per cell */                                        \
+		struct vsi_raster raster = { 0 };                                                                        \
+                                                                                                                         \
+		if ((params)->vsi_raster_spacing > 0)                                                                    \
+			vsi_raster_build(&raster, layout.at, layout.BOX, layout.half_width, layout.length,               \
+					 (params)->vsi_raster_spacing, max_vsi);                                         \
+                                                                                                                         \
+		/*  Fluent data structures used in calculation */                                                        \
+                                                                                                                         \
+		/*  expect all zones/threads to be in a single domain */                                                 \
+		Domain *d = Get_Domain(1);                                                                               \
+                                                                                                                         \
+		Thread *t; /*  current cell thread (mesh zone) */                                                        \
+		cell_t c; /*  current cell index w/in the current thread */                                              \
+                                                                                                                         \
+		struct vsi_batch batch = { .threads = gob_omp_threads }; /* one thread's cells, reused across threads */ \
+		bool batch_ok = true;                                                                                    \
+                                                                                                                         \
+		thread_loop_c(t, d) /* loop over all threads in domain */                                                \
+		{                                                                                                        \
+			/* one batch entry per cell of this thread */                                                    \
+			const int n = THREAD_N_ELEMENTS(t);                                                              \
+                                                                                                                         \
+			if (!vsi_batch_reserve(&batch, n)) {                                                             \
+				batch_ok = false;                                                                        \
+				break;                                                                                   \
+			}                                                                                                \
+                                                                                                                         \
+			/* gather cell locations, mapped to the panel frame once per mesh */                             \
+			begin_c_loop_omp(c, t) /* loop over all cells in thread*/                                        \
+			{                                                                                                \
+				batch.x_loc[c] = C_UDMI(c, t, 8);                                                        \
+				batch.y_loc[c] = C_UDMI(c, t, 9);                                                        \
+			}                                                                                                \
+			end_c_loop_omp(c, t);                                                                            \
+                                                                                                                         \
+			/* bilinear samples, or the exact stepped surface fit by fit */                                  \
+			if (raster.values) {                                                                             \
+				begin_c_loop_omp(c, t)                                                                   \
+				{                                                                                        \
+					batch.vsi[c] = vsi_raster_sample(&raster, batch.x_loc[c], batch.y_loc[c]);       \
+				}                                                                                        \
+				end_c_loop_omp(c, t);                                                                    \
+			} else {                                                                                         \
+				layout.stepped_n(&batch, layout.BOX, n);                                                 \
+			}                                                                                                \
+                                                                                                                         \
+			/* clamp and assign vsi to user-defined-memory location*/                                        \
+			begin_c_loop_omp(c, t)                                                                           \
+			{                                                                                                \
+				C_UDMI(c, t, 6) = batch.vsi[c]; /* raw, for re-clamping */                               \
+				C_UDMI(c, t, 4) = clamp(batch.vsi[c], 0, max_vsi);                                       \
+			}                                                                                                \
+			end_c_loop_omp(c, t);                                                                            \
+		}                                                                                                        \
+                                                                                                                         \
+		if (!batch_ok)                                                                                           \
+			Message("VSI: out of memory, cells left unassigned\n");                                          \
+                                                                                                                         \
+		vsi_batch_free(&batch);                                                                                  \
+		vsi_raster_free(&raster);                                                                                \
+		void;                                                                                                    \
+	})
 
 /*******************************************************************************
  * TRONA MINE
@@ -69,146 +194,11 @@
 	*/
 
 /**
- * @brief 
+ * @brief Trona mine (sub critical panel) VSI of every cell, see vsi_stepped_fields.
  * 
- * @param [in] single_part_mesh is the mesh partitioned?
- * @param [in] panel_x_offset displacement to center of old panel
- * @param [in] panel_y_offset displacement to recovery room of old panel
+ * @param [in] params parameter snapshot (panel offsets, zone bounds, max_vsi)
  */
-#define vsi_trona_stepped(single_part_mesh, panel_x_offset, panel_y_offset)                                            \
-	({                                                                                                             \
-		/* retrieve RP variables from Fluent (or set default values) */                                        \
-                                                                                                                       \
-		real max_vsi; /* maximum VSI to clamp output to */                                                     \
-                                                                                                                       \
-		if (RP_Variable_Exists_P("longwallgobs/max_vsi"))                                                      \
-			max_vsi = RP_Get_Real("longwallgobs/max_vsi");                                                 \
-		else                                                                                                   \
-			max_vsi = 0.22;                                                                                \
-                                                                                                                       \
-		/* variables used in calculation */                                                                    \
-                                                                                                                       \
-		real vsi = 0; /* volumetric strain increment*/                                                         \
-		const real BLEND_RANGE_Y = 25; /* (half) width of the blend zone */                                    \
-		real panel_half_width, panel_length;                                                                   \
-		real startup_corner_length;                                                                            \
-		real mid_panel_gateroad_length;                                                                        \
-		real working_face_corner_length;                                                                       \
-                                                                                                                       \
-		real BOX[6] = { 0 };                                                                                   \
-                                                                                                                       \
-		if (single_part_mesh) {                                                                                \
-			panel_half_width = fabs(RP_Get_Real("longwallgobs/single_part_mesh_max_x") -                   \
-						RP_Get_Real("longwallgobs/single_part_mesh_min_x")) /                  \
-					   2;                                                                          \
-			panel_length = fabs(RP_Get_Real("longwallgobs/single_part_mesh_max_y") -                       \
-					    RP_Get_Real("longwallgobs/single_part_mesh_min_y"));                       \
-                                                                                                                       \
-			BOX[3] = 300;                                                                                  \
-			BOX[4] = panel_length - 400;                                                                   \
-		} else {                                                                                               \
-			startup_corner_length = fabs(RP_Get_Real("longwallgobs/startup_room_corner_max_y") -           \
-						     RP_Get_Real("longwallgobs/startup_room_corner_min_y"));           \
-			mid_panel_gateroad_length = fabs(RP_Get_Real("longwallgobs/mid_panel_gateroad_max_y") -        \
-							 RP_Get_Real("longwallgobs/mid_panel_gateroad_min_y"));        \
-			working_face_corner_length = fabs(RP_Get_Real("longwallgobs/working_face_corner_max_y") -      \
-							  RP_Get_Real("longwallgobs/working_face_corner_min_y"));      \
-                                                                                                                       \
-			panel_half_width = fabs(RP_Get_Real("longwallgobs/startup_room_corner_max_x") -                \
-						RP_Get_Real("longwallgobs/startup_room_corner_min_x"));                \
-			panel_length = startup_corner_length + mid_panel_gateroad_length + working_face_corner_length; \
-                                                                                                                       \
-			BOX[3] = startup_corner_length;                                                                \
-			BOX[4] = startup_corner_length + mid_panel_gateroad_length;                                    \
-		}                                                                                                      \
-                                                                                                                       \
-		BOX[1] = panel_half_width;                                                                             \
-		BOX[5] = panel_length;                                                                                 \
-                                                                                                                       \
-		/* Fluent data structures used in calculation */                                                       \
-                                                                                                                       \
-		/* expect all zones/threads to be in a single domain */                                                \
-		Domain *d = Get_Domain(1);                                                                             \
-                                                                                                                       \
-		Thread *t; /* current cell thread (mesh zone) */                                                       \
-		cell_t c; /* current cell index w/in the current thread */                                             \
-                                                                                                                       \
-		/* ND_ND is just 2 for 2D, 3 for 3D */                                                                 \
-		real loc[ND_ND]; /* mesh cell location "vector" */                                                     \
-                                                                                                                       \
-		thread_loop_c(t, d) /* loop over all threads in domain */                                              \
-		{                                                                                                      \
-			begin_c_loop(c, t) /* loop over all cells in thread*/                                          \
-			{                                                                                              \
-				/* get mesh cell location */                                                           \
-				C_CENTROID(loc, c, t);                                                                 \
-                                                                                                                       \
-				/* center of panel is zero and mirrored*/                                              \
-				real x_loc = fabs(loc[0] - panel_x_offset);                                            \
-                                                                                                                       \
-				/* shift Fluent mesh to FLAC3D data zero point at startup room for equations*/         \
-				real y_loc = fabs(loc[1] - panel_y_offset);                                            \
-                                                                                                                       \
-				/* limit vsi function to only within panel domain sizing*/                             \
-				if (x_loc > BOX[1] || y_loc > BOX[5]) {                                                \
-					vsi = 0;                                                                       \
-				} else if (y_loc < BOX[3] - BLEND_RANGE_Y) {                                           \
-					/* normalize to equation*/                                                     \
-					x_loc = -(x_loc - BOX[1]) / BOX[1];                                            \
-					y_loc = y_loc / BOX[5];                                                        \
-                                                                                                                       \
-					vsi = sub_critical_trona_startup_room_corner(x_loc, y_loc);                    \
-				} else if (y_loc < BOX[3] + BLEND_RANGE_Y) {                                           \
-					/* normalize to equation*/                                                     \
-					x_loc = -(x_loc - BOX[1]) / BOX[1];                                            \
-					y_loc = y_loc / BOX[5];                                                        \
-                                                                                                                       \
-					/* calculate fits for both zones*/                                             \
-					const real FUN1 = sub_critical_trona_startup_room_corner(x_loc, y_loc);        \
-					const real FUN2 = sub_critical_trona_mid_panel_gateroad(x_loc);                \
-                                                                                                                       \
-					/* calculate blending factor*/                                                 \
-					const real BLEND_MIX =                                                         \
-						-(y_loc - BOX[3] - BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);               \
-                                                                                                                       \
-					/* linearly interpolate*/                                                      \
-					vsi = FUN1 * BLEND_MIX + FUN2 * (1 - BLEND_MIX);                               \
-				} else if (y_loc < (BOX[4] - BLEND_RANGE_Y - 20)) {                                    \
-					/* normalize to equation*/                                                     \
-					x_loc = -(x_loc - BOX[1]) / BOX[1];                                            \
-                                                                                                                       \
-					vsi = sub_critical_trona_mid_panel_gateroad(x_loc);                            \
-				} else if (y_loc < BOX[4] + BLEND_RANGE_Y + 20) {                                      \
-					/* normalize to equation*/                                                     \
-					const real X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];                               \
-					const real X_LOC_2 = -(x_loc - BOX[1]) / (BOX[1] + 40) + 0.02;                 \
-					y_loc = -(y_loc - BOX[5]) / (BOX[5] - BOX[4]) + 0.012;                         \
-                                                                                                                       \
-					/* calculate fits for both zones*/                                             \
-					const real FUN1 = sub_critical_trona_mid_panel_gateroad(X_LOC_1);              \
-					const real FUN2 = sub_critical_trona_working_face_corner(X_LOC_2, y_loc);      \
-                                                                                                                       \
-					/* calculate blending factor*/                                                 \
-					const real BLEND_MIX =                                                         \
-						-(y_loc - BOX[4] - BLEND_RANGE_Y - 20) / (2 * BLEND_RANGE_Y + 40);     \
-                                                                                                                       \
-					/* linearly interpolate*/                                                      \
-					vsi = FUN1 * BLEND_MIX + FUN2 * (1 - BLEND_MIX);                               \
-				} else {                                                                               \
-					/* normalize to equation*/                                                     \
-					x_loc = -(x_loc - BOX[1]) / (BOX[1] + 40) + 0.02;                              \
-					y_loc = -(y_loc - BOX[5]) / (BOX[5] - BOX[4]) + 0.012;                         \
-                                                                                                                       \
-					vsi = sub_critical_trona_working_face_corner(x_loc, y_loc);                    \
-				}                                                                                      \
-                                                                                                                       \
-				/* clamp and assign vsi to user-defined-memory location*/                              \
-				C_UDMI(c, t, 4) = clamp(vsi, 0, max_vsi);                                              \
-			}                                                                                              \
-		}                                                                                                      \
-		end_c_loop(c, t);                                                                                      \
-		void;                                                                                                  \
-	})
+#define vsi_trona_stepped(params) vsi_stepped_fields(params, vsi_trona_layout)
 
 /*******************************************************************************
  * MINE C
@@ -254,286 +244,11 @@
 	*/
 
 /**
- * @brief 
+ * @brief Mine C (super critical panel) VSI of every cell, see vsi_stepped_fields.
  * 
- * @param single_part_mesh 
- * @param panel_x_offset 
- * @param panel_y_offset 
+ * @param [in] params parameter snapshot (panel offsets, zone bounds, max_vsi)
  */
-#define vsi_mine_C_stepped(single_part_mesh, panel_x_offset, panel_y_offset)                                           \
-	({                                                                                                             \
-		/*  retrieve RP variables from Fluent (or set default values) */                                       \
-                                                                                                                       \
-		real max_vsi; /*  maximum VSI to clamp output to */                                                    \
-                                                                                                                       \
-		if (RP_Variable_Exists_P("longwallgobs/max_vsi"))                                                      \
-			max_vsi = RP_Get_Real("longwallgobs/max_vsi");                                                 \
-		else                                                                                                   \
-			max_vsi = 0.2623;                                                                              \
-                                                                                                                       \
-		/*  variables used in calculation */                                                                   \
-                                                                                                                       \
-		real vsi = 0; /*  volumetric strain increment */                                                       \
-		const real BLEND_RANGE = 15;                                                                           \
-		const real BLEND_RANGE_Y = 25; /*  (half) width of the blend zone */                                   \
-		real panel_half_width, panel_length;                                                                   \
-		real startup_corner_length;                                                                            \
-		real startup_center_length;                                                                            \
-		real mid_panel_gateroad_length;                                                                        \
-		real mid_panel_center_length;                                                                          \
-		real working_face_corner_width, working_face_corner_length;                                            \
-		real working_face_center_width, working_face_center_length;                                            \
-                                                                                                                       \
-		real BOX[7] = { 0 };                                                                                   \
-                                                                                                                       \
-		if (single_part_mesh) {                                                                                \
-			panel_half_width = fabs(RP_Get_Real("longwallgobs/single_part_mesh_max_x") -                   \
-						RP_Get_Real("longwallgobs/single_part_mesh_min_x")) /                  \
-					   2;                                                                          \
-			panel_length = fabs(RP_Get_Real("longwallgobs/single_part_mesh_max_y") -                       \
-					    RP_Get_Real("longwallgobs/single_part_mesh_min_y"));                       \
-                                                                                                                       \
-			BOX[1] = panel_half_width - 100;                                                               \
-			BOX[4] = 190;                                                                                  \
-			BOX[5] = panel_length - 300;                                                                   \
-		} else {                                                                                               \
-			startup_corner_length = fabs(RP_Get_Real("longwallgobs/startup_room_corner_max_y") -           \
-						     RP_Get_Real("longwallgobs/startup_room_corner_min_y"));           \
-			startup_center_length = fabs(RP_Get_Real("longwallgobs/startup_room_center_max_y") -           \
-						     RP_Get_Real("longwallgobs/startup_room_center_min_y"));           \
-			mid_panel_gateroad_length = fabs(RP_Get_Real("longwallgobs/mid_panel_gateroad_max_y") -        \
-							 RP_Get_Real("longwallgobs/mid_panel_gateroad_min_y"));        \
-			mid_panel_center_length = fabs(RP_Get_Real("longwallgobs/mid_panel_center_max_y") -            \
-						       RP_Get_Real("longwallgobs/mid_panel_center_min_y"));            \
-			working_face_corner_width = fabs(RP_Get_Real("longwallgobs/working_face_corner_max_x") -       \
-							 RP_Get_Real("longwallgobs/working_face_corner_min_x"));       \
-			working_face_corner_length = fabs(RP_Get_Real("longwallgobs/working_face_corner_max_y") -      \
-							  RP_Get_Real("longwallgobs/working_face_corner_min_y"));      \
-			working_face_center_width = fabs(RP_Get_Real("longwallgobs/working_face_center_max_x") -       \
-							 RP_Get_Real("longwallgobs/working_face_center_min_x"));       \
-			working_face_center_length = fabs(RP_Get_Real("longwallgobs/working_face_center_max_y") -      \
-							  RP_Get_Real("longwallgobs/working_face_center_min_y"));      \
-                                                                                                                       \
-			panel_half_width = working_face_corner_width + working_face_center_width / 2;                  \
-			panel_length = startup_corner_length + mid_panel_gateroad_length + working_face_corner_length; \
-                                                                                                                       \
-			BOX[1] = working_face_center_width / 2;                                                        \
-			BOX[4] = startup_corner_length;                                                                \
-			BOX[5] = startup_corner_length + mid_panel_gateroad_length;                                    \
-		}                                                                                                      \
-                                                                                                                       \
-		BOX[2] = panel_half_width;                                                                             \
-		BOX[6] = panel_length;                                                                                 \
-                                                                                                                       \
-		/*  Fluent data structures used in calculation */                                                      \
-                                                                                                                       \
-		/*  expect all zones/threads to be in a single domain */                                               \
-		Domain *d = Get_Domain(1);                                                                             \
-                                                                                                                       \
-		Thread *t; /*  current cell thread (mesh zone) */                                                      \
-		cell_t c; /*  current cell index w/in the current thread */                                            \
-                                                                                                                       \
-		/*  ND_ND is just 2 for 2D, 3 for 3D */                                                                \
-		real loc[ND_ND]; /*  mesh cell location "vector" */                                                    \
-                                                                                                                       \
-		thread_loop_c(t, d) /*  loop over all threads in domain */                                             \
-		{                                                                                                      \
-			begin_c_loop(c, t) /*  loop over all cells in thread */                                        \
-			{ /*  get mesh cell location */                                                                \
-				C_CENTROID(loc, c, t);                                                                 \
-                                                                                                                       \
-				/* center of panel is zero and mirrored*/                                              \
-				real x_loc = fabs(loc[0] - panel_x_offset);                                            \
-                                                                                                                       \
-				/* shift Fluent mesh to FLAC3D data zero point at startup room for equations*/         \
-				real y_loc = fabs(loc[1] - panel_y_offset);                                            \
-                                                                                                                       \
-				/*  limit vsi function to only within panel domain sizing */                           \
-				if (x_loc > panel_half_width) {                                                        \
-					vsi = 0;                                                                       \
-				} else if (x_loc < BOX[1] - BLEND_RANGE) {                                             \
-					if (y_loc < 0) {                                                               \
-						vsi = 0;                                                               \
-					} else if (y_loc < BOX[4] - BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = -(x_loc - BOX[1] + 20) / BOX[1];                               \
-						y_loc = y_loc / BOX[4];                                                \
-                                                                                                                       \
-						vsi = super_critical_mine_C_startup_room_center(x_loc, y_loc);         \
-					} else if (y_loc < BOX[4] + BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / (BOX[1]);                     \
-						const real X_LOC_2 = -(x_loc - BOX[1]) / BOX[1];                       \
-						const real Y_LOC_1 = BOX[4];                                           \
-						const real Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_startup_room_center(X_LOC_1, Y_LOC_1);   \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_mid_panel_center(X_LOC_2, Y_LOC_2);      \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX =                                                 \
-							(y_loc - BLEND_RANGE_Y - 15) / (2 * BLEND_RANGE_Y + 30);       \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = (-(x_loc - BOX[1] + 10) / (BOX[1]));                           \
-						y_loc = ((y_loc - BOX[4]) / (BOX[5] - BOX[4]));                        \
-                                                                                                                       \
-						vsi = super_critical_mine_C_mid_panel_center(x_loc, y_loc);            \
-					} else if (y_loc < BOX[5] + BLEND_RANGE_Y + 15) {                              \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];                       \
-						const real X_LOC_2 = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];     \
-						const real Y_LOC_1 = (y_loc - BOX[4] - 100) / (BOX[5] - BOX[4]);       \
-						const real Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);         \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_mid_panel_center(X_LOC_1, Y_LOC_1);      \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_working_face_center(X_LOC_2, Y_LOC_2);   \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX = -(y_loc - BOX[5] - BLEND_RANGE_Y - 15) /        \
-								       (2 * BLEND_RANGE_Y + 30);                       \
-                                                                                                                       \
-						/*  linerally interpolate */                                           \
-						vsi = FUN1 * BLEND_MIX + FUN2 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[6]) {                                                   \
-						/*  normalize to equation */                                           \
-						x_loc = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];                  \
-						y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);                      \
-                                                                                                                       \
-						vsi = super_critical_mine_C_working_face_center(x_loc, y_loc);         \
-					} else {                                                                       \
-						vsi = 0;                                                               \
-					}                                                                              \
-				} else if (x_loc <= BOX[1] + BLEND_RANGE) {                                            \
-					/*  calculate blending factor */                                               \
-					const real BLEND_MIX = (x_loc - BOX[1] + BLEND_RANGE) / (2 * BLEND_RANGE);     \
-                                                                                                                       \
-					if (y_loc < 0) {                                                               \
-						vsi = 0;                                                               \
-					} else if (y_loc < BOX[4]) {                                                   \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];                       \
-						const real X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);         \
-						y_loc /= BOX[4];                                                       \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_startup_room_center(X_LOC_1, y_loc);     \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_startup_room_corner(X_LOC_2, y_loc);     \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc <= BOX[5]) {                                                  \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];                       \
-						const real X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);         \
-						y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);                          \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_mid_panel_center(X_LOC_1, y_loc);        \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_mid_panel_gateroad(X_LOC_2, y_loc);      \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[6]) {                                                   \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 =                                                   \
-							(x_loc - (BOX[1] - BLEND_RANGE)) / (BOX[1] + BLEND_RANGE);     \
-						const real X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);         \
-						y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);                      \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_working_face_center(X_LOC_1, y_loc);     \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_working_face_corner(X_LOC_2, y_loc);     \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else {                                                                       \
-						vsi = 0;                                                               \
-					}                                                                              \
-				} else {                                                                               \
-					if (y_loc < 0) {                                                               \
-						vsi = 0;                                                               \
-					} else if (y_loc < BOX[4] - BLEND_RANGE_Y) {                                   \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						y_loc /= BOX[4];                                                       \
-                                                                                                                       \
-						vsi = super_critical_mine_C_startup_room_corner(x_loc, y_loc);         \
-					} else if (y_loc < BOX[4] + BLEND_RANGE_Y) {                                   \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						const real Y_LOC_1 = y_loc / BOX[4];                                   \
-						const real Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_startup_room_corner(x_loc, Y_LOC_1);     \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_mid_panel_gateroad(x_loc, Y_LOC_2);      \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX =                                                 \
-							(y_loc - BOX[4] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);        \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 20) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);                          \
-                                                                                                                       \
-						vsi = super_critical_mine_C_mid_panel_gateroad(x_loc, y_loc);          \
-					} else if (y_loc < BOX[5] + BLEND_RANGE_Y + 20) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						const real Y_LOC_1 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-						const real Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);         \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_C_mid_panel_gateroad(x_loc, Y_LOC_1);      \
-						const real FUN2 =                                                      \
-							super_critical_mine_C_working_face_corner(x_loc, Y_LOC_2);     \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX =                                                 \
-							((y_loc - BOX[5] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y));      \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < panel_length) {                                             \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);                      \
-                                                                                                                       \
-						vsi = super_critical_mine_C_working_face_corner(x_loc, y_loc);         \
-					} else {                                                                       \
-						vsi = 0;                                                               \
-					}                                                                              \
-				}                                                                                      \
-                                                                                                                       \
-				/*  clamp and assign vsi to user-defined-memory location */                            \
-				C_UDMI(c, t, 4) = clamp(vsi, 0, max_vsi);                                              \
-			}                                                                                              \
-		}                                                                                                      \
-		end_c_loop(c, t);                                                                                      \
-		void;                                                                                                  \
-	})
+#define vsi_mine_C_stepped(params) vsi_stepped_fields(params, vsi_mine_C_layout)
 
 /*******************************************************************************
  * MINE E
@@ -579,285 +294,33 @@
 	*/
 
 /**
- * @brief 
+ * @brief Mine E (super critical panel) VSI of every cell, see vsi_stepped_fields.
  * 
- * @param single_part_mesh 
- * @param panel_x_offset 
- * @param panel_y_offset 
+ * @param [in] params parameter snapshot (panel offsets, zone bounds, max_vsi)
+ */
+#define vsi_mine_E_stepped(params) vsi_stepped_fields(params, vsi_mine_E_layout)
+
+/**
+ * @brief Re-applies the max_vsi clamp to the raw VSI (udm-6) stored by the
+ * last vsi_*_stepped run, without evaluating the surface again.
+ *
+ * @param [in] params parameter snapshot (max_vsi)
  */
-#define vsi_mine_E_stepped(single_part_mesh, panel_x_offset, panel_y_offset)                                           \
-	({                                                                                                             \
-		/*  retrieve RP variables from Fluent (or set default values) */                                       \
-                                                                                                                       \
-		real max_vsi; /*  maximum VSI to clamp output to */                                                    \
-                                                                                                                       \
-		if (RP_Variable_Exists_P("longwallgobs/max_vsi"))                                                      \
-			max_vsi = RP_Get_Real("longwallgobs/max_vsi");                                                 \
-		else                                                                                                   \
-			max_vsi = 0.179;                                                                               \
-                                                                                                                       \
-		/*  variables used in calculation */                                                                   \
-                                                                                                                       \
-		real vsi = 0; /*  volumetric strain increment */                                                       \
-		const real BLEND_RANGE = 20;                                                                           \
-		const real BLEND_RANGE_Y = 20; /*  (half) width of the blend zone */                                   \
-		real panel_half_width, panel_length;                                                                   \
-		real startup_corner_length;                                                                            \
-		real startup_center_length;                                                                            \
-		real mid_panel_gateroad_length;                                                                        \
-		real mid_panel_center_length;                                                                          \
-		real working_face_corner_width, working_face_corner_length;                                            \
-		real working_face_center_width, working_face_center_length;                                            \
-                                                                                                                       \
-		real BOX[7] = { 0 };                                                                                   \
-                                                                                                                       \
-		if (single_part_mesh) {                                                                                \
-			panel_half_width = fabs(RP_Get_Real("longwallgobs/single_part_mesh_max_x") -                   \
-						RP_Get_Real("longwallgobs/single_part_mesh_min_x")) /                  \
-					   2;                                                                          \
-			panel_length = fabs(RP_Get_Real("longwallgobs/single_part_mesh_max_y") -                       \
-					    RP_Get_Real("longwallgobs/single_part_mesh_min_y"));                       \
-                                                                                                                       \
-			BOX[1] = panel_half_width - 100;                                                               \
-			BOX[4] = 190;                                                                                  \
-			BOX[5] = panel_length - 300;                                                                   \
-		} else {                                                                                               \
-			startup_corner_length = fabs(RP_Get_Real("longwallgobs/startup_room_corner_max_y") -           \
-						     RP_Get_Real("longwallgobs/startup_room_corner_min_y"));           \
-			startup_center_length = fabs(RP_Get_Real("longwallgobs/startup_room_center_max_y") -           \
-						     RP_Get_Real("longwallgobs/startup_room_center_min_y"));           \
-			mid_panel_gateroad_length = fabs(RP_Get_Real("longwallgobs/mid_panel_gateroad_max_y") -        \
-							 RP_Get_Real("longwallgobs/mid_panel_gateroad_min_y"));        \
-			mid_panel_center_length = fabs(RP_Get_Real("longwallgobs/mid_panel_center_max_y") -            \
-						       RP_Get_Real("longwallgobs/mid_panel_center_min_y"));            \
-			working_face_corner_width = fabs(RP_Get_Real("longwallgobs/working_face_corner_max_x") -       \
-							 RP_Get_Real("longwallgobs/working_face_corner_min_x"));       \
-			working_face_corner_length = fabs(RP_Get_Real("longwallgobs/working_face_corner_max_y") -      \
-							  RP_Get_Real("longwallgobs/working_face_corner_min_y"));      \
-			working_face_center_width = fabs(RP_Get_Real("longwallgobs/working_face_center_max_x") -       \
-							 RP_Get_Real("longwallgobs/working_face_center_min_x"));       \
-			working_face_center_length = fabs(RP_Get_Real("longwallgobs/working_face_center_max_y") -      \
-							  RP_Get_Real("longwallgobs/working_face_center_min_y"));      \
-                                                                                                                       \
-			panel_half_width = working_face_corner_width + working_face_center_width / 2;                  \
-			panel_length = startup_corner_length + mid_panel_gateroad_length + working_face_corner_length; \
-                                                                                                                       \
-			BOX[1] = working_face_center_width / 2;                                                        \
-			BOX[4] = startup_corner_length;                                                                \
-			BOX[5] = startup_corner_length + mid_panel_gateroad_length;                                    \
-		}                                                                                                      \
-                                                                                                                       \
-		BOX[2] = panel_half_width;                                                                             \
-		BOX[6] = panel_length;                                                                                 \
-                                                                                                                       \
-		/*  Fluent data structures used in calculation */                                                      \
-                                                                                                                       \
-		/*  expect all zones/threads to be in a single domain */                                               \
-		Domain *d = Get_Domain(1);                                                                             \
-                                                                                                                       \
-		Thread *t; /*  current cell thread (mesh zone) */                                                      \
-		cell_t c; /*  current cell index w/in the current thread */                                            \
-                                                                                                                       \
-		/*  ND_ND is just 2 for 2D, 3 for 3D */                                                                \
-		real loc[ND_ND]; /*  mesh cell location "vector" */                                                    \
-                                                                                                                       \
-		thread_loop_c(t, d)                                                                                    \
-		{                                                                                                      \
-			begin_c_loop(c, t)                                                                             \
-			{                                                                                              \
-				/*  get mesh cell location */                                                          \
-				C_CENTROID(loc, c, t);                                                                 \
-                                                                                                                       \
-				/* center of panel is zero and mirrored*/                                              \
-				real x_loc = fabs(loc[0] - panel_x_offset);                                            \
-                                                                                                                       \
-				/* shift Fluent mesh to FLAC3D data zero point at startup room for equations*/         \
-				real y_loc = fabs(loc[1] - panel_y_offset);                                            \
-                                                                                                                       \
-				/*  limit vsi function to only within panel domain sizing */                           \
-				if (x_loc > panel_half_width) {                                                        \
-					vsi = 0;                                                                       \
-				} else if (x_loc < BOX[1] - BLEND_RANGE) {                                             \
-					if (y_loc < 0) {                                                               \
-						vsi = 0;                                                               \
-					} else if (y_loc < BOX[4] - BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = -(x_loc - BOX[1] + 20) / BOX[1];                               \
-						y_loc /= BOX[4];                                                       \
-                                                                                                                       \
-						vsi = super_critical_mine_E_startup_room_center(x_loc, y_loc);         \
-					} else if (y_loc < BOX[4] + BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1] + 20) / BOX[1];                  \
-						const real X_LOC_2 = -(x_loc - BOX[1] + 10) / BOX[1];                  \
-						const real Y_LOC_1 = y_loc / BOX[4];                                   \
-						const real Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_startup_room_center(X_LOC_1, Y_LOC_1);   \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_mid_panel_center(X_LOC_2, Y_LOC_2);      \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX =                                                 \
-							(y_loc - (BOX[4] + BLEND_RANGE_Y - 15)) / (2 * BLEND_RANGE_Y); \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = -(x_loc - BOX[1] + 10) / BOX[1];                               \
-						y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);                          \
-                                                                                                                       \
-						vsi = super_critical_mine_E_mid_panel_center(x_loc, y_loc);            \
-					} else if (y_loc < BOX[5] + BLEND_RANGE_Y - 15) {                              \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];                       \
-						const real X_LOC_2 = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];     \
-						const real Y_LOC_1 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-						const real Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);         \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_mid_panel_center(X_LOC_1, Y_LOC_1);      \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_working_face_center(X_LOC_2, Y_LOC_2);   \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX = -((y_loc - (BOX[5] + BLEND_RANGE_Y - 15)) /     \
-									 (2 * BLEND_RANGE_Y));                         \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN1 * BLEND_MIX + FUN2 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[6]) {                                                   \
-						/*  normalize to equation */                                           \
-						x_loc = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];                  \
-						y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);                      \
-                                                                                                                       \
-						vsi = super_critical_mine_E_working_face_center(x_loc, y_loc);         \
-					} else {                                                                       \
-						vsi = 0;                                                               \
-					}                                                                              \
-				} else if (x_loc <= BOX[1] + BLEND_RANGE) {                                            \
-					/*  calculate blending factor */                                               \
-					const real BLEND_MIX = (x_loc - BOX[1] + BLEND_RANGE) / (2 * BLEND_RANGE);     \
-                                                                                                                       \
-					if (y_loc < 0) {                                                               \
-						vsi = 0;                                                               \
-					} else if (y_loc < BOX[4]) {                                                   \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];                       \
-						const real X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);         \
-						y_loc /= BOX[4];                                                       \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_startup_room_center(X_LOC_1, y_loc);     \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_startup_room_corner(X_LOC_2, y_loc);     \
-                                                                                                                       \
-						/*  linerally interpolate */                                           \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc <= BOX[5]) {                                                  \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = -(x_loc - BOX[1]) / (BOX[1]);                     \
-						const real X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);         \
-						y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);                          \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_mid_panel_center(X_LOC_1, y_loc);        \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_mid_panel_gateroad(X_LOC_2, y_loc);      \
-                                                                                                                       \
-						/*  linerally interpolate */                                           \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[6]) {                                                   \
-						/*  normalize to equation */                                           \
-						const real X_LOC_1 = (x_loc - (BOX[1])) / (BOX[1]);                    \
-						const real X_LOC_2 = 1 - (x_loc - (BOX[1])) / (BOX[2] - BOX[1]);       \
-						y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);                      \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_working_face_center(X_LOC_1, y_loc);     \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_working_face_corner(X_LOC_2, y_loc);     \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else {                                                                       \
-						vsi = 0;                                                               \
-					}                                                                              \
-				} else {                                                                               \
-					if (y_loc < 0) {                                                               \
-						vsi = 0;                                                               \
-					} else if (y_loc < BOX[4] - BLEND_RANGE_Y) {                                   \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						y_loc /= BOX[4];                                                       \
-                                                                                                                       \
-						vsi = super_critical_mine_E_startup_room_corner(x_loc, y_loc);         \
-					} else if (y_loc < BOX[4] + BLEND_RANGE_Y) {                                   \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						const real Y_LOC_1 = y_loc / BOX[4];                                   \
-						const real Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-                                                                                                                       \
-						/*  calculate fits for both equations */                               \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_startup_room_corner(x_loc, Y_LOC_1);     \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_mid_panel_gateroad(x_loc, Y_LOC_2);      \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX =                                                 \
-							(y_loc - BOX[4] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);        \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 20) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);                          \
-                                                                                                                       \
-						vsi = super_critical_mine_E_mid_panel_gateroad(x_loc, y_loc);          \
-					} else if (y_loc < BOX[5] + BLEND_RANGE_Y + 20) {                              \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						const real Y_LOC_1 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);             \
-						const real Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);         \
-                                                                                                                       \
-						/*  calculate fits for both zones */                                   \
-						const real FUN1 =                                                      \
-							super_critical_mine_E_mid_panel_gateroad(x_loc, Y_LOC_1);      \
-						const real FUN2 =                                                      \
-							super_critical_mine_E_working_face_corner(x_loc, Y_LOC_2);     \
-                                                                                                                       \
-						/*  calculate blending factor */                                       \
-						const real BLEND_MIX =                                                 \
-							(y_loc - BOX[5] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);        \
-                                                                                                                       \
-						/*  linearly interpolate */                                            \
-						vsi = FUN2 * BLEND_MIX + FUN1 * (1 - BLEND_MIX);                       \
-					} else if (y_loc < panel_length) {                                             \
-						/*  normalize to equation */                                           \
-						x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);                      \
-						y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);                      \
-                                                                                                                       \
-						vsi = super_critical_mine_E_working_face_corner(x_loc, y_loc);         \
-					} else {                                                                       \
-						vsi = 0;                                                               \
-					}                                                                              \
-				}                                                                                      \
-                                                                                                                       \
-				/*  clamp and assign vsi to user-defined-memory location */                            \
-				C_UDMI(c, t, 4) = clamp(vsi, 0, max_vsi);                                              \
-			}                                                                                              \
-		}                                                                                                      \
-		end_c_loop(c, t);                                                                                      \
-		void;                                                                                                  \
+#define clamp_vsi(params)                                                                       \
+	({                                                                                      \
+		Domain *d = Get_Domain(1);                                                      \
+		Thread *t;                                                                      \
+		cell_t c;                                                                       \
+                                                                                                \
+		thread_loop_c(t, d)                                                             \
+		{                                                                               \
+			begin_c_loop_omp(c, t)                                                  \
+			{                                                                       \
+				C_UDMI(c, t, 4) = clamp(C_UDMI(c, t, 6), 0, (params)->max_vsi); \
+			}                                                                       \
+			end_c_loop_omp(c, t);                                                   \
+		}                                                                               \
+		void;                                                                           \
 	})
 
 #endif // GOB_UDF_VSI_H
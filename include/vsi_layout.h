@@ -0,0 +1,62 @@
+/**
+ * @file vsi_layout.h
+ *
+ * @brief Zone layout (BOX[]) of each mine model's stepped VSI surface, built
+ * from the selected zones or the single part mesh. See udf_vsi.h for the
+ * layouts themselves.
+ */
+
+#ifndef GOB_VSI_LAYOUT_H
+#define GOB_VSI_LAYOUT_H
+
+#include "params.h" // for struct gob_params
+#include "vsi_stepped.h" // for vsi_classify_fn, vsi_point_fn, vsi_stepped_fn
+
+struct vsi_layout {
+	double BOX[VSI_BOX_SIZE]; // zone layout (6 entries for trona)
+	double half_width; // panel half width (m)
+	double length; // panel length (m)
+	vsi_classify_fn classify; // point classifier of the mine model
+	vsi_stepped_fn stepped_n; // batch evaluator of the mine model and mesh mode
+	vsi_point_fn at; // point evaluator of the mine model
+};
+
+/**
+ * @brief Signature shared by the layout builders below.
+ */
+typedef void (*vsi_layout_fn)(struct vsi_layout *layout, const struct gob_params *params);
+
+/**
+ * @brief Trona mine (sub critical panel) layout.
+ *
+ * @param [out] layout zone layout
+ * @param [in] params parameter snapshot (zone bounds)
+ */
+void vsi_trona_layout(struct vsi_layout *layout, const struct gob_params *params);
+
+/**
+ * @brief Mine C (super critical panel) layout.
+ *
+ * @param [out] layout zone layout
+ * @param [in] params parameter snapshot (zone bounds)
+ */
+void vsi_mine_C_layout(struct vsi_layout *layout, const struct gob_params *params);
+
+/**
+ * @brief Mine E (super critical panel) layout.
+ *
+ * @param [out] layout zone layout
+ * @param [in] params parameter snapshot (zone bounds)
+ */
+void vsi_mine_E_layout(struct vsi_layout *layout, const struct gob_params *params);
+
+/**
+ * @brief Layout builder of the selected mine model (the last one udf_main
+ * computes, if several are selected).
+ *
+ * @param [in] params parameter snapshot (mine selection)
+ * @return [vsi_layout_fn] builder, NULL if no mine is selected
+ */
+vsi_layout_fn vsi_layout_of(const struct gob_params *params);
+
+#endif // GOB_VSI_LAYOUT_H
@@ -0,0 +1,64 @@
+/**
+ * @file vsi_raster.h
+ *
+ * @brief Tabulated VSI surface over a whole panel. The stepped + blended
+ * surface is evaluated once on a regular grid in normalized panel
+ * coordinates; cells then bilinearly sample the grid instead of evaluating
+ * the exponential fits themselves.
+ */
+
+#ifndef GOB_VSI_RASTER_H
+#define GOB_VSI_RASTER_H
+
+#include <stdbool.h>
+
+#include "vsi_stepped.h" // for vsi_point_fn
+
+struct vsi_raster {
+	int nx; // grid nodes across the (half) panel width
+	int ny; // grid nodes along the panel length
+	double width; // panel half width (m)
+	double length; // panel length (m)
+	double inv_dx; // 1 / node spacing across the panel (1/m)
+	double inv_dy; // 1 / node spacing along the panel (1/m)
+	double *values; // ny rows of nx clamped VSI values; NULL if not built
+	double max_error; // largest |bilinear - exact| found at raster cell centers
+};
+
+/**
+ * @brief Tabulates a stepped VSI surface and reports the grid resolution and
+ * estimated interpolation error.
+ *
+ * @param [out] raster raster to fill (left empty on failure)
+ * @param [in] vsi_at point evaluator of the mine model (vsi_*_stepped_at)
+ * @param [in] BOX zone layout passed through to vsi_at
+ * @param [in] width panel half width (m)
+ * @param [in] length panel length (m)
+ * @param [in] spacing requested node spacing (m)
+ * @param [in] max_vsi upper clamp applied before tabulating, so fit overshoot
+ * outside [0, max_vsi] does not leak into neighbouring samples
+ * @return [true] raster built
+ * @return [false] bad geometry or out of memory; evaluate per cell instead
+ */
+bool vsi_raster_build(struct vsi_raster *raster, vsi_point_fn vsi_at, const double *BOX, const double width,
+		      const double length, const double spacing, const double max_vsi);
+
+/**
+ * @brief Bilinearly samples the raster. Points outside the panel give 0, the
+ * same as the stepped surface.
+ *
+ * @param [in] raster built raster
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @return [double] volumetric strain increment, within [0, max_vsi]
+ */
+double vsi_raster_sample(const struct vsi_raster *raster, const double x_loc, const double y_loc);
+
+/**
+ * @brief Releases the raster's grid.
+ *
+ * @param [in,out] raster raster to empty
+ */
+void vsi_raster_free(struct vsi_raster *raster);
+
+#endif // GOB_VSI_RASTER_H
@@ -0,0 +1,227 @@
+/**
+ * @file vsi_stepped.h
+ *
+ * @brief Piecewise (stepped + blended) VSI surfaces of all three mine models.
+ * See udf_vsi.h for the zone layouts these reproduce.
+ *
+ * Evaluation is split in two: classifying a point finds its region of the
+ * panel and the normalized coordinates of the (one or two) fits that apply
+ * there; evaluating then runs the fits. Whole arrays of points are evaluated
+ * fit by fit with the batched fits (fits_batch.h), so each fit sees one
+ * homogeneous group of points instead of a branch per point.
+ *
+ * Coordinates are in meters, measured from the panel center line (x_loc,
+ * mirrored) and from the startup/recovery room edge (y_loc). BOX[] is the
+ * zone layout built by the matching vsi_*_stepped macro. Results are NOT
+ * clamped to max_vsi.
+ */
+
+#ifndef GOB_VSI_STEPPED_H
+#define GOB_VSI_STEPPED_H
+
+#include <stdbool.h>
+
+/* entries of a zone layout (BOX[0] unused, trona uses up to BOX[5]) */
+#define VSI_BOX_SIZE 7
+
+/* zone edges a single part mesh cannot measure, fixed by the layouts (m) */
+#define VSI_TRONA_SINGLE_PART_BOX_3 300 // startup room corner length
+#define VSI_SUPER_CRITICAL_SINGLE_PART_BOX_4 190 // startup room corner length
+
+/* every equation fit, as a uniform f(x, y) */
+enum vsi_fit {
+	VSI_FIT_TRONA_WORKING_FACE_CORNER,
+	VSI_FIT_TRONA_MID_PANEL_GATEROAD, // ignores y
+	VSI_FIT_TRONA_STARTUP_ROOM_CORNER,
+	VSI_FIT_E_STARTUP_ROOM_CENTER,
+	VSI_FIT_E_MID_PANEL_CENTER,
+	VSI_FIT_E_WORKING_FACE_CENTER,
+	VSI_FIT_E_WORKING_FACE_CORNER,
+	VSI_FIT_E_STARTUP_ROOM_CORNER,
+	VSI_FIT_E_MID_PANEL_GATEROAD,
+	VSI_FIT_C_STARTUP_ROOM_CENTER,
+	VSI_FIT_C_MID_PANEL_CENTER,
+	VSI_FIT_C_WORKING_FACE_CENTER,
+	VSI_FIT_C_WORKING_FACE_CORNER,
+	VSI_FIT_C_STARTUP_ROOM_CORNER,
+	VSI_FIT_C_MID_PANEL_GATEROAD,
+	VSI_FIT_COUNT
+};
+
+/* fits.h function name of each fit, for reports */
+extern const char *const VSI_FIT_NAMES[VSI_FIT_COUNT];
+
+/**
+ * @brief Evaluates one fit at one point (fits.h).
+ *
+ * @param [in] fit enum vsi_fit
+ * @param [in] x normalized x
+ * @param [in] y normalized y (ignored by the trona gateroad fit)
+ * @return [double] fit value
+ */
+double vsi_fit(const int fit, const double x, const double y);
+
+/**
+ * @brief Evaluates one fit at n points (fits_batch.h).
+ *
+ * @param [in] fit enum vsi_fit
+ * @param [in] x normalized x of each point
+ * @param [in] y normalized y of each point
+ * @param [out] out fit value of each point
+ * @param [in] n number of points
+ */
+void vsi_fit_n(const int fit, const double *x, const double *y, double *out, const int n);
+
+/* kind of panel region a point falls in */
+enum vsi_region {
+	VSI_REGION_OUTSIDE, // outside the panel, VSI is 0
+	VSI_REGION_PURE, // a single fit
+	VSI_REGION_BLEND_X, // two fits blended across a zone edge in x
+	VSI_REGION_BLEND_Y // two fits blended across a zone edge in y
+};
+
+/* a classified point: vsi = F(fit[0]) * blend + F(fit[1]) * (1 - blend) */
+struct vsi_sample {
+	int region; // enum vsi_region
+	int fit[2]; // enum vsi_fit of each fit, fit[1] unused for a pure region
+	double x[2]; // normalized x of each fit
+	double y[2]; // normalized y of each fit
+	double blend; // weight of fit[0]
+};
+
+/**
+ * @brief Signature shared by the point classifiers below.
+ */
+typedef void (*vsi_classify_fn)(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample);
+
+/**
+ * @brief Signature shared by the point evaluators below.
+ */
+typedef double (*vsi_point_fn)(double x_loc, double y_loc, const double *BOX);
+
+/**
+ * @brief Classifies one point of a trona mine (sub critical) panel.
+ *
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @param [in] BOX zone layout, 6 entries
+ * @param [out] sample region and fit coordinates of the point
+ */
+void vsi_trona_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample);
+
+/**
+ * @brief Classifies one point of a mine C (super critical) panel.
+ *
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @param [in] BOX zone layout, 7 entries
+ * @param [out] sample region and fit coordinates of the point
+ */
+void vsi_mine_C_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample);
+
+/**
+ * @brief Classifies one point of a mine E (super critical) panel.
+ *
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @param [in] BOX zone layout, 7 entries
+ * @param [out] sample region and fit coordinates of the point
+ */
+void vsi_mine_E_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample);
+
+/**
+ * @brief Trona mine (sub critical panel) VSI at one point.
+ *
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @param [in] BOX zone layout, 6 entries
+ * @return [double] unclamped volumetric strain increment
+ */
+double vsi_trona_stepped_at(double x_loc, double y_loc, const double *BOX);
+
+/**
+ * @brief Mine C (super critical panel) VSI at one point.
+ *
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @param [in] BOX zone layout, 7 entries
+ * @return [double] unclamped volumetric strain increment
+ */
+double vsi_mine_C_stepped_at(double x_loc, double y_loc, const double *BOX);
+
+/**
+ * @brief Mine E (super critical panel) VSI at one point.
+ *
+ * @param [in] x_loc distance from panel center line (m)
+ * @param [in] y_loc distance from recovery room edge (m)
+ * @param [in] BOX zone layout, 7 entries
+ * @return [double] unclamped volumetric strain increment
+ */
+double vsi_mine_E_stepped_at(double x_loc, double y_loc, const double *BOX);
+
+/* points to evaluate together, plus scratch space; reuse across calls */
+struct vsi_batch {
+	int threads; // OpenMP threads to split the work across (<= 1 runs serially)
+	int capacity; // points the arrays can hold
+	double *x_loc; // [in] distance from panel center line (m)
+	double *y_loc; // [in] distance from recovery room edge (m)
+	double *vsi; // [out] unclamped volumetric strain increment
+	struct vsi_sample *samples; // classified points
+	double *fit_x, *fit_y, *fit_out; // fit evaluations grouped by fit, 2 per point
+	int *fit_ref; // where each grouped evaluation came from (2 * point + slot)
+	double *fit_value; // fit results per point and slot
+};
+
+/**
+ * @brief Grows a batch to hold at least n points.
+ *
+ * @param [in,out] batch batch to grow (zero-initialized before first use)
+ * @param [in] n number of points
+ * @return [true] batch can hold n points
+ * @return [false] out of memory, batch unchanged
+ */
+bool vsi_batch_reserve(struct vsi_batch *batch, const int n);
+
+/**
+ * @brief Releases a batch's arrays.
+ *
+ * @param [in,out] batch batch to empty
+ */
+void vsi_batch_free(struct vsi_batch *batch);
+
+/**
+ * @brief Evaluates a stepped VSI surface at the first n points of a batch:
+ * classifies every point, runs each fit once over all points that need it,
+ * then blends.
+ *
+ * @param [in,out] batch points in x_loc/y_loc, results in vsi
+ * @param [in] classify point classifier of the mine model (vsi_*_classify)
+ * @param [in] BOX zone layout passed through to classify
+ * @param [in] n number of points
+ */
+void vsi_stepped_n(struct vsi_batch *batch, vsi_classify_fn classify, const double *BOX, const int n);
+
+/**
+ * @brief Signature shared by the specialized evaluators below.
+ */
+typedef void (*vsi_stepped_fn)(struct vsi_batch *batch, const double *BOX, const int n);
+
+/**
+ * @brief vsi_stepped_n specialized for one mine model and mesh mode (single
+ * part mesh or partitioned): the classifier is inlined into the point loop
+ * and the mine model, blend widths and the layout entries a single part mesh
+ * fixes are compile-time constants. Same results as vsi_stepped_n with the
+ * matching classifier. The zone layout builders pick one (vsi_layout.h).
+ *
+ * @param [in,out] batch points in x_loc/y_loc, results in vsi
+ * @param [in] BOX zone layout of the mine model and mesh mode
+ * @param [in] n number of points
+ */
+void vsi_trona_stepped_n(struct vsi_batch *batch, const double *BOX, const int n);
+void vsi_trona_single_part_stepped_n(struct vsi_batch *batch, const double *BOX, const int n);
+void vsi_mine_C_stepped_n(struct vsi_batch *batch, const double *BOX, const int n);
+void vsi_mine_C_single_part_stepped_n(struct vsi_batch *batch, const double *BOX, const int n);
+void vsi_mine_E_stepped_n(struct vsi_batch *batch, const double *BOX, const int n);
+void vsi_mine_E_single_part_stepped_n(struct vsi_batch *batch, const double *BOX, const int n);
+
+#endif // GOB_VSI_STEPPED_H
@@ -0,0 +1,35 @@
+/**
+ * @file zone_bounds.h
+ *
+ * @brief Bounding boxes of the zones the GUI assigned a role, measured by the
+ * UDF itself: one pass over the vertices of the interior cells of the
+ * selected threads, rotated onto the panel axes (panel_frame.h), a min and a
+ * max reduction across the nodes, and the result stored in the
+ * longwallgobs/<role>_{min,max}_{x,y} RP variables that params.c reads. The
+ * GUI runs it on "OK"; see README.md, "Zone Bounds".
+ */
+
+#ifndef GOB_ZONE_BOUNDS_H
+#define GOB_ZONE_BOUNDS_H
+
+#include <stdbool.h>
+
+#include "udf.h" // Fluent macros
+
+#include "params.h" // for struct gob_params, struct gob_options
+
+/**
+ * @brief Measures every selected zone and sets its bound RP variables on the
+ * host (or the serial process). Every process must call it: the nodes sweep
+ * their cells and reduce, node zero sends the result to the host.
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] params panel angle (the offsets go unused)
+ * @param [in] options zone ids of the roles (-1 = none)
+ * @return [true] every selected zone had cells and was stored
+ * @return [false] some selected zone has no cells here; it keeps its old
+ * bounds (reported by the host)
+ */
+bool gob_zone_bounds_measure(Domain *d, const struct gob_params *params, const struct gob_options *options);
+
+#endif // GOB_ZONE_BOUNDS_H
@@ -0,0 +1,41 @@
+/**
+ * @file zone_stats.h
+ *
+ * @brief Statistics of the gob fields per panel zone, gathered in one pass
+ * over the domain and written to longwallgobs-zones.json.
+ *
+ * Each zone the GUI assigned a role (startup room center, mid-panel gateroad,
+ * ...) gets one entry, named after its first role and listing all of its
+ * roles; every other cell zone is pooled as "other". Per entry:
+ * cell count and volume; the volume-weighted mean, min, max and histogram
+ * (volume per bin) of the VSI, porosity, viscous and inertial resistance; and
+ * the volume of each explosive gas zone class. The histogram bins span the
+ * range each field is clamped to, so one pass is enough.
+ */
+
+#ifndef GOB_ZONE_STATS_H
+#define GOB_ZONE_STATS_H
+
+#include <stdbool.h>
+
+#include "udf.h" // Fluent macros
+
+#include "params.h" // for struct gob_params, struct gob_options
+
+/* histogram bins per field */
+#define ZONE_STATS_N_BINS 10
+
+/**
+ * @brief Gathers the statistics and writes the JSON file. Node only; every
+ * node must call it since it reduces across nodes (node zero writes).
+ *
+ * @param [in] d domain holding the gob cell threads
+ * @param [in] params parameters the fields were computed from (for the ranges)
+ * @param [in] options run settings the fields were computed with (for the zones)
+ * @param [in] explosive_mix the EGZ classes (udm-7) are up to date
+ * @return [true] file written (always true on nodes other than zero)
+ */
+bool gob_zone_stats_write(Domain *d, const struct gob_params *params, const struct gob_options *options,
+			  const bool explosive_mix);
+
+#endif // GOB_ZONE_STATS_H
@@ -1,49 +1,110 @@
+/*
+ * Reads a combined bounds report in one pass and writes a panel descriptor
+ * the UDF can load instead of measuring the zones (see panel_descriptor.h and
+ * README.md, "Zone Bounds"):
+ *
+ *	parser <report> <zone id> <surface> ...
+ *
+ * with one zone id and surface name pair per role, in enum gob_role order
+ * ("-1 -" for a role without a zone). The report holds four appended
+ * surface-integrals reports over every selected surface, in this order:
+ * vertex-min x, vertex-max x, vertex-min y, vertex-max y. Each lists one
+ * "<surface> <value>" line per surface, so a surface showing up again starts
+ * the next report; titles, units, rules and totals are skipped whatever their
+ * layout.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
-#include <vector>
+#include <iostream>
+#include <sstream>
 #include <string>
 
-int main()
+#include "panel_descriptor.h"
+
+int main(int argc, char *argv[])
 {
-	// mesh zone names
-	const std::vector<std::string> ZONES{ "startup_room_center_min_x", "startup_room_center_max_x",
-					      "startup_room_center_min_y", "startup_room_center_max_y",
+	if (argc != 2 + 2 * GOB_PANEL_N_ZONES) {
+		std::cerr << "usage: parser <report> <zone id> <surface> ... (" << GOB_PANEL_N_ZONES << " pairs)\n";
+		return 1;
+	}
 
-					      "startup_room_corner_min_x", "startup_room_corner_max_x",
-					      "startup_room_corner_min_y", "startup_room_corner_max_y",
+	// never leave the descriptor of an earlier Apply behind
+	std::remove(GOB_PANEL_FILE);
 
-					      "mid_panel_center_min_x",	   "mid_panel_center_max_x",
-					      "mid_panel_center_min_y",	   "mid_panel_center_max_y",
+	struct gob_panel_zone zones[GOB_PANEL_N_ZONES]{};
+	std::string surfaces[GOB_PANEL_N_ZONES];
 
-					      "mid_panel_gateroad_min_x",  "mid_panel_gateroad_max_x",
-					      "mid_panel_gateroad_min_y",  "mid_panel_gateroad_max_y",
+	for (int role{ 0 }; role < GOB_PANEL_N_ZONES; ++role) {
+		zones[role].zone_id = std::stoi(argv[2 + 2 * role]);
+		surfaces[role] = argv[3 + 2 * role];
+	}
 
-					      "working_face_center_min_x", "working_face_center_max_x",
-					      "working_face_center_min_y", "working_face_center_max_y",
+	std::ifstream report{ argv[1] };
+	if (report.fail()) {
+		std::cerr << "parser: cannot open " << argv[1] << '\n';
+		return 1;
+	}
 
-					      "working_face_corner_min_x", "working_face_corner_max_x",
-					      "working_face_corner_min_y", "working_face_corner_max_y",
+	// bound each report holds, and the roles each of them reached
+	double gob_panel_zone::*const BOUNDS[]{ &gob_panel_zone::min_x, &gob_panel_zone::max_x,
+						 &gob_panel_zone::min_y, &gob_panel_zone::max_y };
+	const int N_BOUNDS{ sizeof(BOUNDS) / sizeof(BOUNDS[0]) };
+	unsigned found[GOB_PANEL_N_ZONES]{};
+	int bound{ 0 };
+	bool seen[GOB_PANEL_N_ZONES]{};
 
-					      "single_part_mesh_min_x",	   "single_part_mesh_max_x",
-					      "single_part_mesh_min_y",	   "single_part_mesh_max_y" };
+	std::string line;
+	while (std::getline(report, line)) {
+		std::istringstream fields{ line };
+		std::string surface;
+		double value;
 
-	// Scheme script to set rp variables when loaded by Fluent
-	std::ofstream output{ "set_dimensions.scm" };
+		if (!(fields >> surface >> value))
+			continue; // not a value line
 
-	std::string temp;
-	double num{ 0 };
+		for (int role{ 0 }; role < GOB_PANEL_N_ZONES; ++role) {
+			if (zones[role].zone_id < 0 || surfaces[role] != surface)
+				continue;
+
+			if (seen[role]) {
+				std::memset(seen, 0, sizeof(seen));
+				++bound;
+			}
+
+			if (bound >= N_BOUNDS) {
+				std::cerr << "parser: more than " << N_BOUNDS << " reports in " << argv[1] << '\n';
+				return 1;
+			}
+
+			// a surface shared by several roles gives all of them its value
+			for (int other{ role }; other < GOB_PANEL_N_ZONES; ++other)
+				if (zones[other].zone_id >= 0 && surfaces[other] == surface) {
+					zones[other].*BOUNDS[bound] = value;
+					found[other] |= 1u << bound;
+					seen[other] = true;
+				}
+			break;
+		}
+	}
 
-	for (const auto zone : ZONES) {
-		std::ifstream report{ zone + ".txt" };
-		if (report.fail())
-			continue; // zone missing, skip it
+	for (int role{ 0 }; role < GOB_PANEL_N_ZONES; ++role)
+		if (zones[role].zone_id >= 0 && found[role] != (1u << N_BOUNDS) - 1) {
+			std::cerr << "parser: " << argv[1] << " lacks bounds of surface " << surfaces[role] << '\n';
+			return 1;
+		}
 
-		// skip exactly 12 strings before the first value in the report
-		for (std::size_t i{ 0 }; i < 12u; ++i)
-			report >> temp;
+	std::ofstream output{ GOB_PANEL_FILE, std::ios::binary };
+	const std::uint32_t HEADER[]{ GOB_PANEL_VERSION, GOB_PANEL_N_ZONES };
 
-		report >> num;
+	output.write(GOB_PANEL_MAGIC, 8);
+	output.write(reinterpret_cast<const char *>(HEADER), sizeof(HEADER));
+	output.write(reinterpret_cast<const char *>(zones), sizeof(zones));
 
-		// the actual Scheme command to set this RP variable
-		output << "(rpsetvar 'longwallgobs/" << zone << ' ' << num << ")\n";
+	if (!output) {
+		std::cerr << "parser: cannot write " << GOB_PANEL_FILE << '\n';
+		return 1;
 	}
 }
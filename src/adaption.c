@@ -0,0 +1,154 @@
+/**
+ * @file adaption.c
+ *
+ * @brief Fields of the cells a mesh adaption added, see adaption.h.
+ */
+
+#include <stdlib.h> // for malloc, free
+
+#include "adaption.h"
+#include "fits_batch.h" // for fits_batch_set_precision
+#include "omp_loop.h" // for gob_omp_threads
+#include "panel_frame.h"
+#include "properties.h" // for gob_porosity, gob_resistances
+#include "utils.h" // for clamp
+#include "vsi_layout.h"
+#include "vsi_raster.h"
+
+/* the new cells of one thread, gathered into a batch */
+struct new_cells {
+	struct vsi_batch batch;
+	cell_t *cells; // cell of each batch point
+	int capacity;
+};
+
+static bool reserve(struct new_cells *cells, const int n)
+{
+	if (n <= cells->capacity)
+		return true;
+
+	cell_t *grown = malloc(n * sizeof(*grown));
+
+	if (!grown || !vsi_batch_reserve(&cells->batch, n)) {
+		free(grown);
+		return false;
+	}
+
+	free(cells->cells);
+	cells->cells = grown;
+	cells->capacity = n;
+
+	return true;
+}
+
+/* stores the panel coordinates of the cells whose centroid moved away from
+   them and gathers those cells; returns how many */
+static int gather(struct new_cells *cells, Thread *t, const struct gob_panel_frame *frame)
+{
+	int n = 0;
+	cell_t c;
+
+	begin_c_loop(c, t)
+	{
+		real loc[ND_ND];
+		double x_loc, y_loc;
+
+		C_CENTROID(loc, c, t);
+		gob_panel_frame_map(frame, loc[0], loc[1], &x_loc, &y_loc);
+
+		// compared as stored, so old cells match exactly; zeroed memory never does
+		if (C_UDMI(c, t, 8) == (real)x_loc && C_UDMI(c, t, 9) == (real)y_loc &&
+		    (C_UDMI(c, t, 8) != 0 || C_UDMI(c, t, 9) != 0))
+			continue;
+
+		C_UDMI(c, t, 8) = x_loc;
+		C_UDMI(c, t, 9) = y_loc;
+
+		// the batch reads the coordinates back as stored, like vsi_stepped_fields
+		cells->cells[n] = c;
+		cells->batch.x_loc[n] = C_UDMI(c, t, 8);
+		cells->batch.y_loc[n] = C_UDMI(c, t, 9);
+		++n;
+	}
+	end_c_loop(c, t);
+
+	return n;
+}
+
+int gob_adaption_refresh(Domain *d, const struct gob_params *params)
+{
+	struct gob_panel_frame frame;
+	gob_panel_frame_of(&frame, params);
+
+	struct gob_property_model model;
+	gob_property_model_init(&model, params);
+
+	// no mine selected: udf_main leaves the VSI as it is, too
+	const vsi_layout_fn LAYOUT_FN = vsi_layout_of(params);
+	struct vsi_layout layout;
+
+	if (LAYOUT_FN) {
+		LAYOUT_FN(&layout, params);
+		fits_batch_set_precision(params->fit_precision);
+	}
+
+	struct new_cells cells = { .batch = { .threads = gob_omp_threads } };
+	struct vsi_raster raster = { 0 };
+	bool raster_tried = false;
+	int n_new = 0;
+	bool ok = true;
+
+	Thread *t;
+
+	thread_loop_c(t, d)
+	{
+		if (!reserve(&cells, THREAD_N_ELEMENTS(t))) {
+			ok = false;
+			break;
+		}
+
+		const int N = gather(&cells, t, &frame);
+
+		if (N == 0)
+			continue;
+
+		// tabulated once, and only when some cells need it
+		if (LAYOUT_FN && params->vsi_raster_spacing > 0 && !raster_tried) {
+			vsi_raster_build(&raster, layout.at, layout.BOX, layout.half_width, layout.length,
+					 params->vsi_raster_spacing, params->max_vsi);
+			raster_tried = true;
+		}
+
+		if (raster.values)
+			for (int i = 0; i < N; ++i)
+				cells.batch.vsi[i] = vsi_raster_sample(&raster, cells.batch.x_loc[i], cells.batch.y_loc[i]);
+		else if (LAYOUT_FN)
+			layout.stepped_n(&cells.batch, layout.BOX, N);
+
+		// the same steps, on the stored values, as vsi_stepped_fields and calc_gob_properties
+		for (int i = 0; i < N; ++i) {
+			const cell_t c = cells.cells[i];
+
+			if (LAYOUT_FN) {
+				C_UDMI(c, t, 6) = cells.batch.vsi[i];
+				C_UDMI(c, t, 4) = clamp(cells.batch.vsi[i], 0, params->max_vsi);
+			}
+
+			C_UDMI(c, t, 1) = gob_porosity(&model, C_UDMI(c, t, 4));
+
+			real viscous, inertial;
+			gob_resistances(&model, C_UDMI(c, t, 1), &viscous, &inertial);
+
+			C_UDMI(c, t, 0) = viscous;
+			C_UDMI(c, t, 5) = inertial;
+		}
+
+		n_new += N;
+	}
+
+	vsi_batch_free(&cells.batch);
+	free(cells.cells);
+	vsi_raster_free(&raster);
+
+	return ok ? n_new : -1;
+}
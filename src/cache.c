@@ -0,0 +1,182 @@
+/**
+ * @file cache.c
+ *
+ * @brief On-disk cache of the computed VSI and gob property fields.
+ *
+ * File layout (native endianness, one file per compute node):
+ *	header: magic, version, sizeof(real), slot count, key, thread count
+ *	per thread: thread id, cell count, then each cached slot as a
+ *	contiguous array of reals (slot-major so reads/writes stay sequential)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "cache.h"
+#include "utils.h" // for hash_word, hash_double
+
+#define GOB_CACHE_MAGIC "GOBCACHE"
+
+/* bump whenever fits.c or the stepped VSI macros change what they compute */
+#define GOB_CACHE_VERSION 2u
+
+#define GOB_CACHE_N_SLOTS 5
+
+/* user-defined-memory slots saved: resistance, porosity, VSI, inertial resistance, raw VSI */
+static const int CACHED_SLOTS[GOB_CACHE_N_SLOTS] = { 0, 1, 4, 5, 6 };
+
+struct cache_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t real_size;
+	uint32_t n_slots;
+	uint32_t n_threads;
+	uint64_t key;
+};
+
+static void cache_file_name(char *name, const size_t size)
+{
+#if PARALLEL
+	snprintf(name, size, "longwallgobs-%d.cache", myid);
+#else
+	snprintf(name, size, "longwallgobs.cache");
+#endif
+}
+
+uint64_t gob_cache_key(Domain *d, const struct gob_params *params)
+{
+	uint64_t hash = HASH_INIT;
+
+	hash = hash_word(hash, GOB_CACHE_VERSION);
+	hash = hash_word(hash, gob_params_hash(params));
+
+	Thread *t;
+	cell_t c;
+	real loc[ND_ND];
+
+	thread_loop_c(t, d)
+	{
+		hash = hash_word(hash, (uint64_t)THREAD_ID(t));
+		hash = hash_word(hash, (uint64_t)THREAD_N_ELEMENTS(t));
+
+		begin_c_loop(c, t)
+		{
+			C_CENTROID(loc, c, t);
+
+			for (int i = 0; i < ND_ND; ++i)
+				hash = hash_double(hash, loc[i]);
+		}
+		end_c_loop(c, t);
+	}
+
+	return hash;
+}
+
+uint64_t gob_fields_hash(Domain *d)
+{
+	uint64_t hash = HASH_INIT;
+	Thread *t;
+	cell_t c;
+
+	thread_loop_c(t, d)
+	{
+		begin_c_loop(c, t)
+		{
+			for (int s = 0; s < GOB_CACHE_N_SLOTS; ++s)
+				hash = hash_double(hash, C_UDMI(c, t, CACHED_SLOTS[s]));
+		}
+		end_c_loop(c, t);
+	}
+
+	// 0 is reserved for "no fields"
+	return hash ? hash : 1;
+}
+
+bool gob_cache_load(Domain *d, const uint64_t key)
+{
+	char name[64];
+	cache_file_name(name, sizeof(name));
+
+	FILE *file = fopen(name, "rb");
+	if (!file)
+		return false;
+
+	struct cache_header header;
+	bool ok = fread(&header, sizeof(header), 1, file) == 1 &&
+		  !memcmp(header.magic, GOB_CACHE_MAGIC, sizeof(header.magic)) &&
+		  header.version == GOB_CACHE_VERSION && header.real_size == sizeof(real) &&
+		  header.n_slots == GOB_CACHE_N_SLOTS && header.key == key;
+
+	Thread *t;
+	cell_t c;
+	uint32_t n_threads = 0;
+
+	thread_loop_c(t, d)
+	{
+		if (!ok)
+			break;
+
+		int32_t ids[2]; // thread id, cell count
+		ok = fread(ids, sizeof(ids), 1, file) == 1 && ids[0] == THREAD_ID(t) &&
+		     ids[1] == THREAD_N_ELEMENTS(t);
+
+		for (int s = 0; ok && s < GOB_CACHE_N_SLOTS; ++s) {
+			begin_c_loop(c, t)
+			{
+				if (fread(&C_UDMI(c, t, CACHED_SLOTS[s]), sizeof(real), 1, file) != 1) {
+					ok = false;
+					break;
+				}
+			}
+			end_c_loop(c, t);
+		}
+
+		++n_threads;
+	}
+
+	fclose(file);
+
+	return ok && n_threads == header.n_threads;
+}
+
+bool gob_cache_save(Domain *d, const uint64_t key)
+{
+	char name[64];
+	cache_file_name(name, sizeof(name));
+
+	FILE *file = fopen(name, "wb");
+	if (!file)
+		return false;
+
+	Thread *t;
+	cell_t c;
+
+	struct cache_header header = { .version = GOB_CACHE_VERSION,
+				       .real_size = sizeof(real),
+				       .n_slots = GOB_CACHE_N_SLOTS,
+				       .key = key };
+	memcpy(header.magic, GOB_CACHE_MAGIC, sizeof(header.magic));
+
+	thread_loop_c(t, d)
+	{
+		++header.n_threads;
+	}
+
+	bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+	thread_loop_c(t, d)
+	{
+		const int32_t ids[2] = { THREAD_ID(t), THREAD_N_ELEMENTS(t) };
+		ok = ok && fwrite(ids, sizeof(ids), 1, file) == 1;
+
+		for (int s = 0; ok && s < GOB_CACHE_N_SLOTS; ++s) {
+			begin_c_loop(c, t)
+			{
+				ok = ok && fwrite(&C_UDMI(c, t, CACHED_SLOTS[s]), sizeof(real), 1, file) == 1;
+			}
+			end_c_loop(c, t);
+		}
+	}
+
+	return (fclose(file) == 0) && ok;
+}
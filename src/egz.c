@@ -0,0 +1,161 @@
+/**
+ * @file egz.c
+ *
+ * @brief Explosive gas zone classes on the Coward diagram.
+ */
+
+#include <math.h> // for fabs
+#include <stdbool.h>
+
+#include "egz.h"
+
+/* molecular weights (g/mol) for the lookup table */
+#define MOLAR_MASS_CH4 16.043
+#define MOLAR_MASS_O2 31.9988
+#define MOLAR_MASS_N2 28.0134
+
+/*
+	A grid cell is only tabulated if every boundary stays at least this far
+	from it, measured as the boundary line scaled by the mixture's moles per
+	gram (see boundary_value). That is >= 1.6e-4 in mole fractions, far beyond
+	the round-off of the exact classifier even in single precision.
+*/
+#define EGZ_LUT_MARGIN 1e-5
+
+unsigned char egz_lut[EGZ_LUT_N][EGZ_LUT_N];
+
+const real EGZ_DISPLAY[EGZ_N_CLASSES] = {
+	[EGZ_EXPLOSIVE] = 1.0E0,
+	[EGZ_NEAR_EXPLOSIVE] = 0.81E0,
+	[EGZ_FUEL_RICH_INERT] = 0.66E0,
+	[EGZ_OXYGEN_LEAN_INERT_A] = 0.48E0,
+	[EGZ_OXYGEN_LEAN_INERT_DARK] = 0.0E0,
+	[EGZ_OXYGEN_LEAN_INERT_B] = 0.48E0,
+	[EGZ_OXYGEN_RICH_INERT] = 0.27E0,
+	[EGZ_UNCLASSIFIED] = 2.66E0,
+};
+
+int egz_classify_exact(const real Y_CH4, const real Y_O2)
+{
+	real px;
+	real py;
+	real u;
+	real v;
+	real u1;
+	real v1;
+	real w;
+	real Y_N2, MW_CH4, MW_O2, MW_N2, MW_Mix, X_CH4, X_O2;
+
+	/* Y_X = Mass Fraction of Species X  || X_X = Mole Fraction of Species X */
+	Y_N2 = 1.0 - Y_CH4 - Y_O2;
+	MW_CH4 = 16.043;
+	MW_O2 = 31.9988;
+	MW_N2 = 28.0134;
+	MW_Mix = 1 / (Y_CH4 / MW_CH4 + Y_O2 / MW_O2 + Y_N2 / MW_N2);
+	X_CH4 = (Y_CH4 * MW_Mix) / MW_CH4; /* X = Mole Fraction of X */
+	X_O2 = (Y_O2 * MW_Mix) / MW_O2;
+	px = X_CH4;
+	py = X_O2;
+	u = 0.8529 * px + 0.0606; /* Near Explosive to Explosive Slope */
+	v = -0.21 * px + 0.21; /* Upper Explosive Limit  */
+	u1 = 0.8864 * px + 0.0445; /* Near Explosive to Requires Air Slope */
+	v1 = -1.3929 * px + 0.195;
+	w = v1;
+	/*v1=-1.2647*px+0.1771; Cyan to Yellow Slope Transition */
+
+	/*w=-1.8545*px+0.2095; Continuation of Slope Oxygen Rich to Oxygen Poor */
+
+	/* Explosive Zone - RED */
+	if (py > u && px > 0.055 && py < v)
+		return EGZ_EXPLOSIVE;
+
+	/* Near Explosive Zone - ORANGE */
+	if (py > u1 && px > 0.04 && py < v)
+		return EGZ_NEAR_EXPLOSIVE;
+
+	/* Fuel Rich Inert - YELLOW */
+	if (py < u1 && py > v1 && px > 0.055)
+		return EGZ_FUEL_RICH_INERT;
+
+	/* Oxygen Lean Inert - Green A  */
+	if (py < v1 && px > 0.04)
+		return EGZ_OXYGEN_LEAN_INERT_A;
+
+	/* Oxygen Lean Inert - DARK  GREEN  */
+	if (py < 0.08 && px < 0.04)
+		return EGZ_OXYGEN_LEAN_INERT_DARK;
+
+	/* Oxygen Lean Inert - Green B  */
+	if (py < w && px < 0.04)
+		return EGZ_OXYGEN_LEAN_INERT_B;
+
+	/* Oxygen Rich Inert - CYAN */
+	if (py > w)
+		return EGZ_OXYGEN_RICH_INERT;
+
+	/* Explosive Zone - DARK BLUE */
+	return EGZ_UNCLASSIFIED;
+}
+
+/* boundary a * px + b * py + c = 0 of the diagram, in mole fractions */
+struct egz_boundary {
+	double a, b, c;
+};
+
+static const struct egz_boundary BOUNDARIES[] = {
+	{ -0.8529, 1, -0.0606 }, // py = u
+	{ 0.21, 1, -0.21 }, // py = v
+	{ -0.8864, 1, -0.0445 }, // py = u1
+	{ 1.3929, 1, -0.195 }, // py = v1 = w
+	{ 1, 0, -0.055 },
+	{ 1, 0, -0.04 },
+	{ 0, 1, -0.08 },
+};
+
+/*
+	a * px + b * py + c times the moles per gram of mixture, which is linear in
+	the mass fractions (and positive over [0, 1]^2)
+*/
+static double boundary_value(const struct egz_boundary *line, const double Y_CH4, const double Y_O2)
+{
+	const double MOLES = Y_CH4 / MOLAR_MASS_CH4 + Y_O2 / MOLAR_MASS_O2 + (1 - Y_CH4 - Y_O2) / MOLAR_MASS_N2;
+
+	return line->a * Y_CH4 / MOLAR_MASS_CH4 + line->b * Y_O2 / MOLAR_MASS_O2 + line->c * MOLES;
+}
+
+/* no boundary crosses or comes within the margin of the grid cell */
+static bool clear_of_boundaries(const double Y_CH4_0, const double Y_CH4_1, const double Y_O2_0,
+				const double Y_O2_1)
+{
+	for (size_t i = 0; i < sizeof(BOUNDARIES) / sizeof(BOUNDARIES[0]); ++i) {
+		// a linear function keeps one sign over the cell iff it does at its corners
+		const double CORNERS[4] = { boundary_value(&BOUNDARIES[i], Y_CH4_0, Y_O2_0),
+					    boundary_value(&BOUNDARIES[i], Y_CH4_1, Y_O2_0),
+					    boundary_value(&BOUNDARIES[i], Y_CH4_0, Y_O2_1),
+					    boundary_value(&BOUNDARIES[i], Y_CH4_1, Y_O2_1) };
+
+		for (int k = 0; k < 4; ++k)
+			if (fabs(CORNERS[k]) < EGZ_LUT_MARGIN || (CORNERS[k] > 0) != (CORNERS[0] > 0))
+				return false;
+	}
+
+	return true;
+}
+
+void egz_lut_build(void)
+{
+	static bool built = false;
+
+	if (built)
+		return;
+
+	const double H = 1.0 / EGZ_LUT_N;
+
+	for (int j = 0; j < EGZ_LUT_N; ++j)
+		for (int i = 0; i < EGZ_LUT_N; ++i)
+			egz_lut[j][i] = clear_of_boundaries(i * H, (i + 1) * H, j * H, (j + 1) * H) ?
+						(unsigned char)egz_classify_exact((i + 0.5) * H, (j + 0.5) * H) :
+						EGZ_BOUNDARY;
+
+	built = true;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file explosive_log.c
+ *
+ * @brief Time series of the explosive gas volume.
+ */
+
+#include <stdio.h>
+
+#include "explosive_log.h"
+
+#define GOB_EXPLOSIVE_LOG "longwallgobs-explosive.log"
+
+void gob_explosive_log_append(const int iteration, const real flow_time, const real explosive_volume)
+{
+#if !RP_HOST
+	if (!I_AM_NODE_ZERO_P)
+		return;
+
+	FILE *file = fopen(GOB_EXPLOSIVE_LOG, "a");
+	if (!file)
+		return;
+
+	// a new (empty) file gets a header line
+	if (ftell(file) == 0)
+		fprintf(file, "# iteration flow_time(s) explosive_volume(m^3)\n");
+
+	fprintf(file, "%d %.9g %.9g\n", iteration, (double)flow_time, (double)explosive_volume);
+	fclose(file);
+#endif
+}
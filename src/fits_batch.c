@@ -0,0 +1,305 @@
+/**
+ * @file fits_batch.c
+ *
+ * @brief Batched equation fits with runtime instruction set dispatch.
+ *
+ * The vector paths evaluate the same expressions as fits.c (fits_expr.h) with
+ * vector exp/log kernels (fits_batch_kernel.h) that are within 1 ULP of the C
+ * library (measured over the whole double range), and pow(a, b) is
+ * exp(b log(a)). Rounding differs from the scalar fits, including FMA
+ * contraction on the AVX2/AVX-512 paths, so fits that cancel to near zero can
+ * be off by many ULP of the result itself. Measured against the scalar fits
+ * on a 1000 x 1000 grid over x, y in [-0.2, 1.5], the largest difference was
+ * 5 ULP of max(|fit|, 1) (mine E working face corner); FITS_BATCH_MAX_ULP
+ * documents 8.
+ *
+ * The faster precision tiers cut the Taylor series of exp and the R(z)
+ * series of log short, and flush exp to zero where even the largest
+ * coefficient of a fit (about 40) times exp leaves the result unchanged at
+ * the tier's accuracy. A vector whose lanes are all flushed skips the series
+ * altogether, which is most of the stiff terms (exp(-7883 x^2),
+ * exp(-2890 y), ...) over most of the panel. Measured the same way as
+ * above, the largest differences were 8.3e-9 (FITS_PRECISION_1E7)
+ * and 5.4e-6 (FITS_PRECISION_1E4) of max(|fit|, 1).
+ *
+ * FITS_PRECISION_FLOAT32 narrows the points to float and runs the same
+ * expressions in float vectors of twice the lanes, with float exp/log kernels.
+ * Lanes whose float result overflows or is NaN are redone with the scalar
+ * fit. Within [0, 1] the largest difference was 2.6e-7 of max(|fit|, 1); over
+ * [-0.2, 1.5] it grows to 4.6e-5, where the terms of the mine E startup room
+ * corner fit (about 100) cancel at negative coordinates.
+ */
+
+#include <math.h> // for fabs
+#include <stdatomic.h> // for the sampled error
+#include <stdlib.h> // for getenv
+#include <string.h> // for memcpy, strcmp
+
+#include "fits.h"
+#include "fits_batch.h"
+#include "fits_expr.h" // for the fit expressions
+
+/* vector kernels need x86-64 and GCC/clang vector extensions */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define FITS_BATCH_SIMD 1
+#else
+#define FITS_BATCH_SIMD 0
+#endif
+
+#if FITS_BATCH_SIMD
+
+/* 1.5 * 2^52: adding it rounds to an integer held in the low mantissa bits */
+#define ROUND_SHIFT 0x1.8p52
+#define ROUND_SHIFT_BITS 0x4338000000000000LL
+
+/* ln(2) split so k * LN2_HI is exact for |k| < 2^20 (fdlibm) */
+#define LOG2_E 1.44269504088896338700e+00
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+#define SQRT_2 1.41421356237309504880
+
+/* 1 / n! */
+#define EXP_C2 (1.0 / 2)
+#define EXP_C3 (1.0 / 6)
+#define EXP_C4 (1.0 / 24)
+#define EXP_C5 (1.0 / 120)
+#define EXP_C6 (1.0 / 720)
+#define EXP_C7 (1.0 / 5040)
+#define EXP_C8 (1.0 / 40320)
+#define EXP_C9 (1.0 / 362880)
+#define EXP_C10 (1.0 / 3628800)
+#define EXP_C11 (1.0 / 39916800)
+#define EXP_C12 (1.0 / 479001600)
+#define EXP_C13 (1.0 / 6227020800)
+
+static const double EXP_TAYLOR[14] = { 1.0,    1.0,    EXP_C2, EXP_C3, EXP_C4,  EXP_C5,  EXP_C6,
+				       EXP_C7, EXP_C8, EXP_C9, EXP_C10, EXP_C11, EXP_C12, EXP_C13 };
+
+/* fdlibm e_log.c minimax coefficients of R(z) */
+#define LG1 6.666666666666735130e-01
+#define LG2 3.999999999940941908e-01
+#define LG3 2.857142874366239149e-01
+#define LG4 2.222219843214978396e-01
+#define LG5 1.818357216161805012e-01
+#define LG6 1.531383769920937332e-01
+#define LG7 1.479819860511658591e-01
+
+/* precision tiers: Taylor degree of exp, terms of log's R(z) (2, 4 or 7) and
+   the argument below which exp is flushed to zero (-746 is where it underflows) */
+#define EXACT_EXP_DEGREE 13
+#define EXACT_LOG_TERMS 7
+#define EXACT_EXP_FLUSH -746.0
+
+#define P7_EXP_DEGREE 8
+#define P7_LOG_TERMS 4
+#define P7_EXP_FLUSH -24.0
+
+#define P4_EXP_DEGREE 6
+#define P4_LOG_TERMS 2
+#define P4_EXP_FLUSH -16.0
+
+/* float32 tier: float splits of the constants above (fdlibm e_logf.c) */
+#define ROUND_SHIFT_F32 0x1.8p23f
+#define ROUND_SHIFT_F32_BITS 0x4b400000
+#define LOG2_E_F32 1.44269504f
+#define LN2_HI_F32 6.9313812256e-01f
+#define LN2_LO_F32 9.0580006145e-06f
+#define SQRT_2_F32 1.41421356f
+#define LG1_F32 6.6666668653e-01f
+#define LG2_F32 4.0000000596e-01f
+#define LG3_F32 2.8571429849e-01f
+#define LG4_F32 2.2222198546e-01f
+
+#define F32_EXP_DEGREE 7
+#define F32_EXP_FLUSH -24.0f
+
+#define BATCH_WIDTH 4
+#define BATCH_TARGET "avx2,fma"
+#define BATCH(name) name##_avx2
+#include "fits_batch_kernel.h"
+#undef BATCH
+#undef BATCH_TARGET
+#undef BATCH_WIDTH
+
+#define BATCH_WIDTH 8
+#define BATCH_TARGET "avx512f"
+#define BATCH(name) name##_avx512
+#include "fits_batch_kernel.h"
+#undef BATCH
+#undef BATCH_TARGET
+#undef BATCH_WIDTH
+
+#endif // FITS_BATCH_SIMD
+
+enum batch_isa { BATCH_ISA_UNKNOWN, BATCH_ISA_SCALAR, BATCH_ISA_AVX2, BATCH_ISA_AVX512 };
+
+/* best instruction set of this CPU, or the one forced by GOB_FITS_BATCH */
+static enum batch_isa batch_isa(void)
+{
+	// resolved once; concurrent first calls resolve to the same value
+	static enum batch_isa isa = BATCH_ISA_UNKNOWN;
+
+	if (isa != BATCH_ISA_UNKNOWN)
+		return isa;
+
+	enum batch_isa best = BATCH_ISA_SCALAR;
+
+#if FITS_BATCH_SIMD
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("avx512f"))
+		best = BATCH_ISA_AVX512;
+	else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+		best = BATCH_ISA_AVX2;
+#endif
+
+	// only ever step down from what the CPU supports
+	const char *forced = getenv("GOB_FITS_BATCH");
+
+	if (forced && !strcmp(forced, "scalar"))
+		best = BATCH_ISA_SCALAR;
+	else if (forced && !strcmp(forced, "avx2") && best > BATCH_ISA_AVX2)
+		best = BATCH_ISA_AVX2;
+
+	isa = best;
+
+	return isa;
+}
+
+const char *fits_batch_isa(void)
+{
+	switch (batch_isa()) {
+	case BATCH_ISA_AVX512:
+		return "avx512";
+	case BATCH_ISA_AVX2:
+		return "avx2";
+	default:
+		return "scalar";
+	}
+}
+
+/* precision tier of the vector paths, and the largest error of the sampled points against the exact fits */
+static int precision = FITS_PRECISION_EXACT;
+static _Atomic double precision_error = 0;
+
+void fits_batch_set_precision(const int tier)
+{
+	precision = (tier == FITS_PRECISION_1E7 || tier == FITS_PRECISION_1E4 || tier == FITS_PRECISION_FLOAT32) ?
+			    tier :
+			    FITS_PRECISION_EXACT;
+	atomic_store(&precision_error, 0);
+}
+
+double fits_batch_precision_error(void)
+{
+	return atomic_load(&precision_error);
+}
+
+#if FITS_BATCH_SIMD
+/* every SAMPLE_STRIDE-th point of a faster tier is checked against the exact scalar fit */
+#define SAMPLE_STRIDE 64
+
+static void sample_error(double (*exact)(const double, const double), const double *x, const double *y,
+			 const double *out, const int n)
+{
+	double worst = 0;
+
+	for (int i = 0; i < n; i += SAMPLE_STRIDE) {
+		const double EXACT = exact(x[i], y ? y[i] : 0);
+		const double SCALE = fabs(EXACT) > 1 ? fabs(EXACT) : 1;
+		const double ERROR = fabs(out[i] - EXACT) / SCALE;
+
+		worst = ERROR > worst ? ERROR : worst;
+	}
+
+	// batches run on several OpenMP threads (offline: pool workers)
+	double seen = atomic_load(&precision_error);
+
+	while (worst > seen && !atomic_compare_exchange_weak(&precision_error, &seen, worst))
+		;
+}
+
+/* the scalar trona gateroad fit as a fit of x and y, for sample_error */
+static double trona_mid_panel_gateroad_xy(const double x, const double y)
+{
+	(void)y;
+
+	return sub_critical_trona_mid_panel_gateroad(x);
+}
+
+#define DISPATCH_TIER(name, isa, ...)             \
+	if (precision == FITS_PRECISION_FLOAT32)  \
+		name##_f32_##isa(__VA_ARGS__);    \
+	else if (precision == FITS_PRECISION_1E4) \
+		name##_p4_##isa(__VA_ARGS__);     \
+	else if (precision == FITS_PRECISION_1E7) \
+		name##_p7_##isa(__VA_ARGS__);     \
+	else                                      \
+		name##_##isa(__VA_ARGS__);
+
+#define DISPATCH(name, sample, ...)                      \
+	switch (batch_isa()) {                           \
+	case BATCH_ISA_AVX512:                           \
+		DISPATCH_TIER(name, avx512, __VA_ARGS__) \
+		sample;                                  \
+		return;                                  \
+	case BATCH_ISA_AVX2:                             \
+		DISPATCH_TIER(name, avx2, __VA_ARGS__)   \
+		sample;                                  \
+		return;                                  \
+	default:                                         \
+		break;                                   \
+	}
+#else
+#define DISPATCH(name, sample, ...)
+#endif
+
+/* public entry points: vector kernel if available, else loop over the scalar
+   fit (which is exact in every tier) */
+#define BATCH_ENTRY_XY(name)                                                      \
+	void name##_n(const double *x, const double *y, double *out, const int n) \
+	{                                                                         \
+		DISPATCH(name,                                                    \
+			 if (precision != FITS_PRECISION_EXACT)                   \
+				 sample_error(name, x, y, out, n),                \
+			 x, y, out, n)                                            \
+                                                                                  \
+		for (int i = 0; i < n; ++i)                                       \
+			out[i] = name(x[i], y[i]);                                \
+	}
+
+#define BATCH_ENTRY_X(name, name_xy)                                     \
+	void name##_n(const double *x, double *out, const int n)         \
+	{                                                                \
+		DISPATCH(name,                                           \
+			 if (precision != FITS_PRECISION_EXACT)          \
+				 sample_error(name_xy, x, NULL, out, n), \
+			 x, out, n)                                      \
+                                                                         \
+		for (int i = 0; i < n; ++i)                              \
+			out[i] = name(x[i]);                             \
+	}
+
+/* TRONA MINE FITS ************************************************************/
+
+BATCH_ENTRY_XY(sub_critical_trona_working_face_corner)
+BATCH_ENTRY_X(sub_critical_trona_mid_panel_gateroad, trona_mid_panel_gateroad_xy)
+BATCH_ENTRY_XY(sub_critical_trona_startup_room_corner)
+
+/* MINE E FITS ****************************************************************/
+
+BATCH_ENTRY_XY(super_critical_mine_E_startup_room_center)
+BATCH_ENTRY_XY(super_critical_mine_E_mid_panel_center)
+BATCH_ENTRY_XY(super_critical_mine_E_working_face_center)
+BATCH_ENTRY_XY(super_critical_mine_E_working_face_corner)
+BATCH_ENTRY_XY(super_critical_mine_E_startup_room_corner)
+BATCH_ENTRY_XY(super_critical_mine_E_mid_panel_gateroad)
+
+/* MINE C FITS ****************************************************************/
+
+BATCH_ENTRY_XY(super_critical_mine_C_startup_room_center)
+BATCH_ENTRY_XY(super_critical_mine_C_mid_panel_center)
+BATCH_ENTRY_XY(super_critical_mine_C_working_face_center)
+BATCH_ENTRY_XY(super_critical_mine_C_working_face_corner)
+BATCH_ENTRY_XY(super_critical_mine_C_startup_room_corner)
+BATCH_ENTRY_XY(super_critical_mine_C_mid_panel_gateroad)
@@ -0,0 +1,388 @@
+/**
+ * @file flammability.c
+ *
+ * @brief Flammability limit polygons of multi-component gas mixtures, loaded
+ * from a data file and compiled into a lookup table.
+ *
+ * Data file: one entry per line, '#' starts a comment, mole fractions as
+ * fractions (not %):
+ *	reference_lfl <LFL>
+ *	balance <molar mass>
+ *	species <C_YI index> <molar mass> fuel <LFL>
+ *	species <C_YI index> <molar mass> oxygen
+ *	species <C_YI index> <molar mass> inert
+ *	region <class> <vertex count> <x_eq x_O2> ...
+ *	default <class>
+ * where the balance is the species whose mass fraction is not solved for
+ * (1 - the sum of the listed ones), and class is an enum egz_class code.
+ */
+
+#include <stdio.h>
+#include <stdlib.h> // for strtod, strtol
+#include <string.h> // for memcpy, memset, strchr, strcmp, strtok
+
+#include "flammability.h"
+
+/*
+	A grid cell is only tabulated if no polygon edge comes within this
+	distance (in mole fractions) of it, far beyond the round-off of the cell
+	coordinates
+*/
+#define FLAM_LUT_MARGIN 1e-6
+
+struct flam_table gob_flammability;
+
+enum flam_role { FLAM_INERT, FLAM_FUEL, FLAM_OXYGEN };
+
+/* the data file as read, before compiling */
+struct flam_definition {
+	int n_species; // 0 = no file loaded
+	int species[FLAM_MAX_SPECIES];
+	int role[FLAM_MAX_SPECIES];
+	double molar_mass[FLAM_MAX_SPECIES];
+	double lfl[FLAM_MAX_SPECIES];
+	double reference_lfl;
+	double balance_molar_mass;
+	int n_regions;
+	struct flam_region regions[FLAM_MAX_REGIONS];
+	int default_class;
+};
+
+#if !RP_NODE
+/* next token of the current line as a number */
+static bool next_number(double *value)
+{
+	const char *token = strtok(NULL, " \t\r\n");
+	char *end;
+
+	if (!token)
+		return false;
+
+	*value = strtod(token, &end);
+	return *end == '\0';
+}
+
+static bool next_class(int *egz_class)
+{
+	double value;
+
+	if (!next_number(&value) || value < 0 || value >= EGZ_N_CLASSES || value != (int)value)
+		return false;
+
+	*egz_class = (int)value;
+	return true;
+}
+
+/* parses one line; returns an error message or NULL */
+static const char *parse_line(struct flam_definition *def, char *line)
+{
+	char *comment = strchr(line, '#');
+	if (comment)
+		*comment = '\0';
+
+	const char *keyword = strtok(line, " \t\r\n");
+	double value;
+
+	if (!keyword)
+		return NULL;
+
+	if (!strcmp(keyword, "reference_lfl")) {
+		if (!next_number(&def->reference_lfl) || def->reference_lfl <= 0)
+			return "expected a positive LFL";
+	} else if (!strcmp(keyword, "balance")) {
+		if (!next_number(&def->balance_molar_mass) || def->balance_molar_mass <= 0)
+			return "expected a positive molar mass";
+	} else if (!strcmp(keyword, "species")) {
+		if (def->n_species == FLAM_MAX_SPECIES)
+			return "too many species";
+
+		const int K = def->n_species;
+
+		if (!next_number(&value) || value < 0 || value != (int)value)
+			return "expected a species index";
+		def->species[K] = (int)value;
+
+		if (!next_number(&def->molar_mass[K]) || def->molar_mass[K] <= 0)
+			return "expected a positive molar mass";
+
+		const char *role = strtok(NULL, " \t\r\n");
+
+		if (role && !strcmp(role, "fuel")) {
+			def->role[K] = FLAM_FUEL;
+
+			if (!next_number(&def->lfl[K]) || def->lfl[K] <= 0)
+				return "expected the positive LFL of the fuel";
+		} else if (role && !strcmp(role, "oxygen")) {
+			def->role[K] = FLAM_OXYGEN;
+		} else if (role && !strcmp(role, "inert")) {
+			def->role[K] = FLAM_INERT;
+		} else {
+			return "expected fuel, oxygen or inert";
+		}
+
+		++def->n_species;
+	} else if (!strcmp(keyword, "region")) {
+		if (def->n_regions == FLAM_MAX_REGIONS)
+			return "too many regions";
+
+		struct flam_region *region = &def->regions[def->n_regions];
+
+		if (!next_class(&region->egz_class))
+			return "expected a class code";
+
+		if (!next_number(&value) || value < 3 || value > FLAM_MAX_VERTICES || value != (int)value)
+			return "expected a vertex count (3 or more)";
+		region->n = (int)value;
+
+		for (int i = 0; i < region->n; ++i)
+			if (!next_number(&region->x[i]) || !next_number(&region->y[i]))
+				return "expected x_eq x_O2 for every vertex";
+
+		++def->n_regions;
+	} else if (!strcmp(keyword, "default")) {
+		if (!next_class(&def->default_class))
+			return "expected a class code";
+	} else {
+		return "unknown keyword";
+	}
+
+	return strtok(NULL, " \t\r\n") ? "unexpected trailing values" : NULL;
+}
+
+static bool parse_definition(struct flam_definition *def, const char *file_name)
+{
+	FILE *file = fopen(file_name, "r");
+
+	if (!file) {
+		Message("Flammability: cannot open %s, using the built-in diagram\n", file_name);
+		return false;
+	}
+
+	// CH4 reference, N2 balance
+	def->reference_lfl = 0.05;
+	def->balance_molar_mass = 28.0134;
+	def->default_class = EGZ_UNCLASSIFIED;
+
+	char line[1024];
+	const char *error = NULL;
+	int line_number = 0;
+
+	while (!error && fgets(line, sizeof(line), file)) {
+		++line_number;
+		error = parse_line(def, line);
+	}
+
+	fclose(file);
+
+	bool fuel = false;
+	bool oxygen = false;
+
+	for (int k = 0; k < def->n_species; ++k) {
+		fuel = fuel || def->role[k] == FLAM_FUEL;
+		oxygen = oxygen || def->role[k] == FLAM_OXYGEN;
+	}
+
+	if (!error && (!fuel || !oxygen || def->n_regions == 0)) {
+		error = "needs a fuel, oxygen and at least one region";
+		line_number = 0;
+	}
+
+	if (error) {
+		Message("Flammability: %s:%d: %s, using the built-in diagram\n", file_name, line_number, error);
+		return false;
+	}
+
+	Message("Flammability: %d species, %d regions from %s\n", def->n_species, def->n_regions, file_name);
+	return true;
+}
+#endif // !RP_NODE
+
+#if PARALLEL
+/* reals in the broadcast buffer */
+#define N_DEFINITION_REALS \
+	(5 + 4 * FLAM_MAX_SPECIES + FLAM_MAX_REGIONS * (2 + 2 * FLAM_MAX_VERTICES))
+
+/* copies the definition into (pack) or out of the broadcast buffer, in one fixed order */
+static void transfer_definition(real *buffer, struct flam_definition *def, const bool pack)
+{
+	int n = 0;
+
+#define TRANSFER(field) ((pack ? (void)(buffer[n] = (real)(field)) : (void)((field) = buffer[n])), ++n)
+
+	TRANSFER(def->n_species);
+	TRANSFER(def->reference_lfl);
+	TRANSFER(def->balance_molar_mass);
+	TRANSFER(def->n_regions);
+	TRANSFER(def->default_class);
+
+	for (int k = 0; k < FLAM_MAX_SPECIES; ++k) {
+		TRANSFER(def->species[k]);
+		TRANSFER(def->role[k]);
+		TRANSFER(def->molar_mass[k]);
+		TRANSFER(def->lfl[k]);
+	}
+
+	for (int r = 0; r < FLAM_MAX_REGIONS; ++r) {
+		TRANSFER(def->regions[r].egz_class);
+		TRANSFER(def->regions[r].n);
+
+		for (int i = 0; i < FLAM_MAX_VERTICES; ++i) {
+			TRANSFER(def->regions[r].x[i]);
+			TRANSFER(def->regions[r].y[i]);
+		}
+	}
+
+#undef TRANSFER
+}
+#endif // PARALLEL
+
+/* crossing-number test */
+static bool inside(const struct flam_region *region, const double x, const double y)
+{
+	bool in = false;
+
+	for (int i = 0, j = region->n - 1; i < region->n; j = i++)
+		if ((region->y[i] > y) != (region->y[j] > y) &&
+		    x < (region->x[j] - region->x[i]) * (y - region->y[i]) / (region->y[j] - region->y[i]) +
+				region->x[i])
+			in = !in;
+
+	return in;
+}
+
+int flam_classify_exact(const struct flam_table *table, const double x_eq, const double x_O2)
+{
+	for (int r = 0; r < table->n_regions; ++r)
+		if (inside(&table->regions[r], x_eq, x_O2))
+			return table->regions[r].egz_class;
+
+	return table->default_class;
+}
+
+#if !RP_HOST
+/* segment (x0, y0)-(x1, y1) meets the box [bx0, bx1] x [by0, by1] (Liang-Barsky clipping) */
+static bool segment_meets_box(const double x0, const double y0, const double x1, const double y1, const double bx0,
+			      const double by0, const double bx1, const double by1)
+{
+	const double P[4] = { x0 - x1, x1 - x0, y0 - y1, y1 - y0 };
+	const double Q[4] = { x0 - bx0, bx1 - x0, y0 - by0, by1 - y0 };
+	double t0 = 0;
+	double t1 = 1;
+
+	for (int k = 0; k < 4; ++k) {
+		if (P[k] == 0) {
+			// parallel to this side and outside it
+			if (Q[k] < 0)
+				return false;
+		} else if (P[k] < 0) {
+			if (Q[k] / P[k] > t1)
+				return false;
+			if (Q[k] / P[k] > t0)
+				t0 = Q[k] / P[k];
+		} else {
+			if (Q[k] / P[k] < t0)
+				return false;
+			if (Q[k] / P[k] < t1)
+				t1 = Q[k] / P[k];
+		}
+	}
+
+	return true;
+}
+
+static int lut_index(const double value)
+{
+	const int I = (int)(value * FLAM_LUT_N);
+
+	return I < 0 ? 0 : (I >= FLAM_LUT_N ? FLAM_LUT_N - 1 : I);
+}
+
+static void compile(struct flam_table *table, const struct flam_definition *def)
+{
+	table->n_species = def->n_species;
+	table->moles_base = 1 / def->balance_molar_mass;
+
+	for (int k = 0; k < def->n_species; ++k) {
+		table->species[k] = def->species[k];
+		table->fuel_coef[k] =
+			def->role[k] == FLAM_FUEL ? def->reference_lfl / (def->lfl[k] * def->molar_mass[k]) : 0;
+		table->oxygen_coef[k] = def->role[k] == FLAM_OXYGEN ? 1 / def->molar_mass[k] : 0;
+		table->moles_coef[k] = 1 / def->molar_mass[k] - table->moles_base;
+	}
+
+	table->n_regions = def->n_regions;
+	memcpy(table->regions, def->regions, sizeof(table->regions));
+	table->default_class = def->default_class;
+
+	// mark the grid cells each polygon edge passes near
+	const double H = 1.0 / FLAM_LUT_N;
+
+	memset(table->lut, 0, sizeof(table->lut));
+
+	for (int r = 0; r < def->n_regions; ++r) {
+		const struct flam_region *region = &def->regions[r];
+
+		for (int i = 0, j = region->n - 1; i < region->n; j = i++) {
+			const double X0 = region->x[j], Y0 = region->y[j];
+			const double X1 = region->x[i], Y1 = region->y[i];
+
+			const int I0 = lut_index((X0 < X1 ? X0 : X1) - FLAM_LUT_MARGIN);
+			const int I1 = lut_index((X0 < X1 ? X1 : X0) + FLAM_LUT_MARGIN);
+			const int J0 = lut_index((Y0 < Y1 ? Y0 : Y1) - FLAM_LUT_MARGIN);
+			const int J1 = lut_index((Y0 < Y1 ? Y1 : Y0) + FLAM_LUT_MARGIN);
+
+			for (int jj = J0; jj <= J1; ++jj)
+				for (int ii = I0; ii <= I1; ++ii)
+					if (segment_meets_box(X0, Y0, X1, Y1, ii * H - FLAM_LUT_MARGIN,
+							      jj * H - FLAM_LUT_MARGIN, (ii + 1) * H + FLAM_LUT_MARGIN,
+							      (jj + 1) * H + FLAM_LUT_MARGIN))
+						table->lut[jj][ii] = EGZ_BOUNDARY;
+		}
+	}
+
+	// no edge comes near the remaining cells, so each center speaks for its whole cell
+	for (int jj = 0; jj < FLAM_LUT_N; ++jj)
+		for (int ii = 0; ii < FLAM_LUT_N; ++ii)
+			if (table->lut[jj][ii] != EGZ_BOUNDARY)
+				table->lut[jj][ii] =
+					(unsigned char)flam_classify_exact(table, (ii + 0.5) * H, (jj + 0.5) * H);
+}
+#endif // !RP_HOST
+
+void flam_load(struct flam_table *table)
+{
+	struct flam_definition def;
+	memset(&def, 0, sizeof(def));
+
+#if !RP_NODE
+	const char *FILE_NAME = RP_Variable_Exists_P("longwallgobs/flammability_file") ?
+					RP_Get_String("longwallgobs/flammability_file") :
+					"";
+
+	// a failed parse may have read part of the file
+	if (FILE_NAME[0] == '\0' || !parse_definition(&def, FILE_NAME))
+		memset(&def, 0, sizeof(def));
+#endif
+
+#if PARALLEL
+	// one message with the whole file
+	real buffer[N_DEFINITION_REALS];
+
+#if RP_HOST
+	transfer_definition(buffer, &def, true);
+#endif
+
+	host_to_node_real(buffer, N_DEFINITION_REALS);
+
+#if RP_NODE
+	transfer_definition(buffer, &def, false);
+#endif
+#endif // PARALLEL
+
+	table->active = def.n_species > 0;
+
+#if !RP_HOST
+	if (table->active)
+		compile(table, &def);
+#endif
+}
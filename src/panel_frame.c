@@ -0,0 +1,49 @@
+/**
+ * @file panel_frame.c
+ *
+ * @brief Panel frame, see panel_frame.h.
+ */
+
+#include <math.h> // for cos, sin, fabs
+
+#include "panel_frame.h"
+#include "utils.h" // for hash_double
+
+void gob_panel_frame_of(struct gob_panel_frame *frame, const struct gob_params *params)
+{
+	frame->cos_angle = cos(params->panel_angle);
+	frame->sin_angle = sin(params->panel_angle);
+	frame->x_offset = params->panel_x_offset;
+	frame->y_offset = params->panel_y_offset;
+}
+
+void gob_panel_frame_axes(const struct gob_panel_frame *frame, const double x, const double y, double *u,
+			  double *v)
+{
+	// width axis (cos, sin), length axis (-sin, cos); exact for a zero angle
+	*u = x * frame->cos_angle + y * frame->sin_angle;
+	*v = y * frame->cos_angle - x * frame->sin_angle;
+}
+
+void gob_panel_frame_map(const struct gob_panel_frame *frame, const double x, const double y, double *x_loc,
+			 double *y_loc)
+{
+	double u, v;
+	gob_panel_frame_axes(frame, x, y, &u, &v);
+
+	// center of panel is zero and mirrored; FLAC3D zero point at the startup room
+	*x_loc = fabs(u - frame->x_offset);
+	*y_loc = fabs(v - frame->y_offset);
+}
+
+uint64_t gob_panel_frame_key(const struct gob_params *params)
+{
+	uint64_t key = HASH_INIT;
+
+	key = hash_double(key, params->panel_angle);
+	key = hash_double(key, params->panel_x_offset);
+	key = hash_double(key, params->panel_y_offset);
+	key = hash_word(key, params->mesh_shape);
+
+	return key ? key : 1;
+}
@@ -0,0 +1,380 @@
+/**
+ * @file params.c
+ *
+ * @brief Parameter snapshot of the VSI and gob property fields, and the
+ * dependency rules between them.
+ */
+
+#include <math.h> // for M_PI
+#include <stdio.h> // for snprintf, FILE
+#include <string.h> // for memset, memcmp
+
+#include "params.h"
+#include "fits_batch.h" // for enum fits_precision
+#include "panel_descriptor.h" // for struct gob_panel_zone, GOB_PANEL_*
+#include "utils.h" // for hash_word
+
+_Static_assert(GOB_PANEL_N_ZONES == GOB_N_ROLES, "one panel descriptor zone per role");
+
+const char *const GOB_ROLE_NAMES[GOB_N_ROLES] = {
+	[GOB_STARTUP_ROOM_CENTER] = "startup_room_center",
+	[GOB_STARTUP_ROOM_CORNER] = "startup_room_corner",
+	[GOB_MID_PANEL_CENTER] = "mid_panel_center",
+	[GOB_MID_PANEL_GATEROAD] = "mid_panel_gateroad",
+	[GOB_WORKING_FACE_CENTER] = "working_face_center",
+	[GOB_WORKING_FACE_CORNER] = "working_face_corner",
+	[GOB_SINGLE_PART_MESH] = "single_part_mesh",
+};
+
+#if !RP_NODE
+/* RP variable, or its default when the GUI has not defined it */
+static real get_real(const char *name, const real fallback)
+{
+	return RP_Variable_Exists_P(name) ? RP_Get_Real(name) : fallback;
+}
+
+/* bounds of the zone assigned to a role */
+static struct gob_zone_bounds *zone_bounds(struct gob_params *params, const int role)
+{
+	struct gob_zone_bounds *const BOUNDS[GOB_N_ROLES] = {
+		[GOB_STARTUP_ROOM_CENTER] = &params->startup_room_center,
+		[GOB_STARTUP_ROOM_CORNER] = &params->startup_room_corner,
+		[GOB_MID_PANEL_CENTER] = &params->mid_panel_center,
+		[GOB_MID_PANEL_GATEROAD] = &params->mid_panel_gateroad,
+		[GOB_WORKING_FACE_CENTER] = &params->working_face_center,
+		[GOB_WORKING_FACE_CORNER] = &params->working_face_corner,
+		[GOB_SINGLE_PART_MESH] = &params->single_part_mesh_bounds,
+	};
+
+	return BOUNDS[role];
+}
+
+static void load_zone(struct gob_zone_bounds *zone, const char *role)
+{
+	char name[96];
+
+	snprintf(name, sizeof(name), "longwallgobs/%s_min_x", role);
+	zone->min_x = RP_Get_Real(name);
+	snprintf(name, sizeof(name), "longwallgobs/%s_max_x", role);
+	zone->max_x = RP_Get_Real(name);
+	snprintf(name, sizeof(name), "longwallgobs/%s_min_y", role);
+	zone->min_y = RP_Get_Real(name);
+	snprintf(name, sizeof(name), "longwallgobs/%s_max_y", role);
+	zone->max_y = RP_Get_Real(name);
+}
+
+/**
+ * @brief Zone bounds from the panel descriptor (longwallgobs/panel_file), one
+ * read instead of four RP variables per role. The descriptor must have been
+ * measured on the zones selected now. Its bounds are along the mesh axes, so
+ * it is refused for a rotated panel (panel_angle set before the call).
+ *
+ * @return [true] bounds loaded
+ * @return [false] no descriptor set, or unusable (reported)
+ */
+static bool load_panel_file(struct gob_params *params, const struct gob_options *options)
+{
+	const char *FILE_NAME =
+		RP_Variable_Exists_P("longwallgobs/panel_file") ? RP_Get_String("longwallgobs/panel_file") : "";
+
+	if (FILE_NAME[0] == '\0')
+		return false;
+
+	// a box along the mesh axes is not the box along the rotated panel axes
+	if (params->panel_angle != 0) {
+		Message("Panel: %s holds bounds along the mesh axes, which do not fit a panel angle of %g deg, "
+			"using the zone bounds RP variables\n",
+			FILE_NAME, (double)(params->panel_angle * 180 / M_PI));
+		return false;
+	}
+
+	FILE *file = fopen(FILE_NAME, "rb");
+	char magic[8];
+	uint32_t header[2]; // version, zones
+	struct gob_panel_zone zones[GOB_PANEL_N_ZONES];
+	bool ok = false;
+
+	if (file) {
+		ok = fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, GOB_PANEL_MAGIC, sizeof(magic)) == 0 &&
+		     fread(header, sizeof(header), 1, file) == 1 && header[0] == GOB_PANEL_VERSION &&
+		     header[1] == GOB_PANEL_N_ZONES && fread(zones, sizeof(zones), 1, file) == 1;
+		fclose(file);
+	}
+
+	if (!ok) {
+		Message("Panel: %s is not a panel descriptor, using the zone bounds RP variables\n", FILE_NAME);
+		return false;
+	}
+
+	for (int role = 0; role < GOB_N_ROLES; ++role)
+		if (zones[role].zone_id != options->zone_ids[role]) {
+			Message("Panel: %s is from other zones (%s: %d, selected %d), using the zone bounds RP variables\n",
+				FILE_NAME, GOB_ROLE_NAMES[role], (int)zones[role].zone_id, options->zone_ids[role]);
+			return false;
+		}
+
+	for (int role = 0; role < GOB_N_ROLES; ++role)
+		*zone_bounds(params, role) = (struct gob_zone_bounds){ zones[role].min_x, zones[role].max_x,
+								       zones[role].min_y, zones[role].max_y };
+
+	return true;
+}
+
+/* offsets of the panel origin (FLAC3D zero point) in the Fluent mesh */
+static void load_offsets(struct gob_params *params)
+{
+	if (params->single_part_mesh) {
+		// midpoint of working face center
+		params->panel_x_offset =
+			(params->single_part_mesh_bounds.max_x + params->single_part_mesh_bounds.min_x) / 2;
+
+		// assumption: startup room MORE POSITIVE than working face
+		params->panel_y_offset = params->single_part_mesh_bounds.max_y;
+	} else if (params->mine_t) {
+		if (params->startup_room_corner.max_y > params->working_face_corner.max_y) {
+			params->panel_x_offset = params->working_face_corner.min_x;
+			params->panel_y_offset = params->startup_room_corner.max_y;
+		} else {
+			params->panel_x_offset = params->working_face_corner.max_x;
+			params->panel_y_offset = params->startup_room_corner.min_y;
+		}
+	} else {
+		// midpoint of working face center
+		params->panel_x_offset = (params->working_face_center.max_x + params->working_face_center.min_x) / 2;
+
+		// working face->startup room along positive y-axis
+		if (params->startup_room_center.max_y > params->working_face_center.max_y)
+			params->panel_y_offset = params->startup_room_center.max_y;
+
+		// working face->startup room along negative y-axis
+		else
+			params->panel_y_offset = params->startup_room_center.min_y;
+	}
+}
+
+static void read_settings(struct gob_params *params, struct gob_options *options)
+{
+	params->mine_c = RP_Get_Boolean("mine_c");
+	params->mine_e = RP_Get_Boolean("mine_e");
+	params->mine_t = RP_Get_Boolean("mine_t");
+
+	for (int role = 0; role < GOB_N_ROLES; ++role) {
+		char name[96];
+
+		snprintf(name, sizeof(name), "longwallgobs/%s_id", GOB_ROLE_NAMES[role]);
+		options->zone_ids[role] = RP_Get_Integer(name);
+	}
+
+	// if not set to default -1, we are using a single part mesh
+	params->single_part_mesh = options->zone_ids[GOB_SINGLE_PART_MESH] >= 0;
+
+	// the zone bounds are measured along the panel axes
+	params->panel_angle = get_real("longwallgobs/panel_angle", 0) * M_PI / 180;
+
+	if (!load_panel_file(params, options))
+		for (int role = 0; role < GOB_N_ROLES; ++role)
+			load_zone(zone_bounds(params, role), GOB_ROLE_NAMES[role]);
+
+	load_offsets(params);
+
+	params->vsi_raster_spacing = get_real("longwallgobs/vsi_raster_spacing", 0);
+
+	// 0 exact, 1 about 1e-7, 2 about 1e-4 (fits_batch.h)
+	const int PRECISION =
+		RP_Variable_Exists_P("longwallgobs/fit_precision") ? RP_Get_Integer("longwallgobs/fit_precision") : 0;
+	params->fit_precision = PRECISION < FITS_PRECISION_EXACT ?
+					FITS_PRECISION_EXACT :
+					(PRECISION > FITS_PRECISION_1E4 ? FITS_PRECISION_1E4 : PRECISION);
+
+	// float32 fits are their own tier
+	params->single_precision =
+		RP_Variable_Exists_P("longwallgobs/single_precision") && RP_Get_Boolean("longwallgobs/single_precision");
+
+	if (params->single_precision)
+		params->fit_precision = FITS_PRECISION_FLOAT32;
+
+	// default of the mine whose VSI is computed last (and so ends up in udm-4)
+	const real DEFAULT_MAX_VSI = params->mine_t ? 0.22 : (params->mine_e ? 0.179 : 0.2623);
+	params->max_vsi = get_real("longwallgobs/max_vsi", DEFAULT_MAX_VSI);
+
+	params->max_porosity = get_real("longwallgobs/max_porosity", 0.4);
+	params->initial_porosity = get_real("longwallgobs/initial_porosity", 1);
+
+	params->resist_scaler = get_real("longwallgobs/resist_scaler", 1);
+	params->max_resistance = get_real("longwallgobs/max_resistance", 5.0E6);
+	params->min_resistance = get_real("longwallgobs/min_resistance", 1.45E5); // equals 6.91e-6 1/m2 permeability
+	params->max_inertial_resistance = get_real("longwallgobs/max_inertial_resistance", 1.3E5);
+	params->min_inertial_resistance = get_real("longwallgobs/min_inertial_resistance", 0);
+	params->reference_porosity = get_real("vsi/initial-porosity", 0.25778);
+
+	options->cache_fields =
+		RP_Variable_Exists_P("longwallgobs/cache_fields") && RP_Get_Boolean("longwallgobs/cache_fields");
+	options->explosive_mix = RP_Get_Boolean("longwallgobs/egz_radio_button");
+	options->omp_threads =
+		RP_Variable_Exists_P("longwallgobs/omp_threads") ? RP_Get_Integer("longwallgobs/omp_threads") : 1;
+	options->egz_max_interval =
+		RP_Variable_Exists_P("longwallgobs/egz_max_interval") ? RP_Get_Integer("longwallgobs/egz_max_interval") : 16;
+	options->egz_tolerance = get_real("longwallgobs/egz_tolerance", 0.01);
+}
+#endif // !RP_NODE
+
+#if PARALLEL
+/* the broadcast buffer holds at most this many settings */
+#define N_SETTINGS_MAX 64
+
+/* copies every setting into (pack) or out of the broadcast buffer, in one fixed order */
+static int transfer_settings(real *buffer, struct gob_params *params, struct gob_options *options, const bool pack)
+{
+	int n = 0;
+
+#define TRANSFER(field) ((pack ? (void)(buffer[n] = (real)(field)) : (void)((field) = buffer[n])), ++n)
+#define TRANSFER_ZONE(zone) \
+	(TRANSFER((zone).min_x), TRANSFER((zone).max_x), TRANSFER((zone).min_y), TRANSFER((zone).max_y))
+
+	TRANSFER(params->mine_c);
+	TRANSFER(params->mine_e);
+	TRANSFER(params->mine_t);
+	TRANSFER(params->single_part_mesh);
+	TRANSFER(params->panel_angle);
+	TRANSFER(params->panel_x_offset);
+	TRANSFER(params->panel_y_offset);
+	TRANSFER_ZONE(params->startup_room_center);
+	TRANSFER_ZONE(params->startup_room_corner);
+	TRANSFER_ZONE(params->mid_panel_center);
+	TRANSFER_ZONE(params->mid_panel_gateroad);
+	TRANSFER_ZONE(params->working_face_center);
+	TRANSFER_ZONE(params->working_face_corner);
+	TRANSFER_ZONE(params->single_part_mesh_bounds);
+	TRANSFER(params->vsi_raster_spacing);
+	TRANSFER(params->fit_precision);
+	TRANSFER(params->single_precision);
+	TRANSFER(params->max_vsi);
+	TRANSFER(params->max_porosity);
+	TRANSFER(params->initial_porosity);
+	TRANSFER(params->resist_scaler);
+	TRANSFER(params->max_resistance);
+	TRANSFER(params->min_resistance);
+	TRANSFER(params->max_inertial_resistance);
+	TRANSFER(params->min_inertial_resistance);
+	TRANSFER(params->reference_porosity);
+	TRANSFER(options->cache_fields);
+	TRANSFER(options->explosive_mix);
+	TRANSFER(options->omp_threads);
+	TRANSFER(options->egz_max_interval);
+	TRANSFER(options->egz_tolerance);
+
+	for (int role = 0; role < GOB_N_ROLES; ++role)
+		TRANSFER(options->zone_ids[role]);
+
+#undef TRANSFER_ZONE
+#undef TRANSFER
+
+	return n;
+}
+#endif // PARALLEL
+
+void gob_params_load(struct gob_params *params, struct gob_options *options, Domain *d)
+{
+	// zero the padding too, so snapshots can be hashed and compared as a whole
+	memset(params, 0, sizeof(*params));
+	memset(options, 0, sizeof(*options));
+
+#if !RP_NODE
+	read_settings(params, options);
+#endif
+
+#if PARALLEL
+	// one message instead of a query per RP variable and node; the nodes pack
+	// their zeroed snapshot only to size it
+	real buffer[N_SETTINGS_MAX];
+	const int N = transfer_settings(buffer, params, options, true);
+
+	host_to_node_real(buffer, N);
+
+#if RP_NODE
+	transfer_settings(buffer, params, options, false);
+#endif
+#endif // PARALLEL
+
+#if !RP_HOST
+	params->mesh_shape = gob_mesh_shape(d);
+#endif
+}
+
+#if !RP_HOST
+uint64_t gob_mesh_shape(Domain *d)
+{
+	// a re-meshed or adapted domain changes thread sizes
+	Thread *t;
+	uint64_t shape = HASH_INIT;
+
+	thread_loop_c(t, d)
+	{
+		shape = hash_word(shape, (uint64_t)THREAD_ID(t));
+		shape = hash_word(shape, (uint64_t)THREAD_N_ELEMENTS(t));
+	}
+
+	return shape;
+}
+#endif
+
+static bool zone_changed(const struct gob_zone_bounds *previous, const struct gob_zone_bounds *current)
+{
+	return previous->min_x != current->min_x || previous->max_x != current->max_x ||
+	       previous->min_y != current->min_y || previous->max_y != current->max_y;
+}
+
+unsigned gob_params_diff(const struct gob_params *previous, const struct gob_params *current)
+{
+	const bool GEOMETRY =
+		previous->mine_c != current->mine_c || previous->mine_e != current->mine_e ||
+		previous->mine_t != current->mine_t || previous->single_part_mesh != current->single_part_mesh ||
+		previous->panel_angle != current->panel_angle || previous->panel_x_offset != current->panel_x_offset ||
+		previous->panel_y_offset != current->panel_y_offset ||
+		zone_changed(&previous->startup_room_center, &current->startup_room_center) ||
+		zone_changed(&previous->startup_room_corner, &current->startup_room_corner) ||
+		zone_changed(&previous->mid_panel_center, &current->mid_panel_center) ||
+		zone_changed(&previous->mid_panel_gateroad, &current->mid_panel_gateroad) ||
+		zone_changed(&previous->working_face_center, &current->working_face_center) ||
+		zone_changed(&previous->working_face_corner, &current->working_face_corner) ||
+		zone_changed(&previous->single_part_mesh_bounds, &current->single_part_mesh_bounds) ||
+		previous->vsi_raster_spacing != current->vsi_raster_spacing ||
+		previous->fit_precision != current->fit_precision ||
+		previous->single_precision != current->single_precision || previous->mesh_shape != current->mesh_shape;
+
+	const bool CLAMP = previous->max_vsi != current->max_vsi;
+
+	const bool POROSITY = previous->max_porosity != current->max_porosity ||
+			      previous->initial_porosity != current->initial_porosity;
+
+	const bool RESISTANCE = previous->resist_scaler != current->resist_scaler ||
+				previous->max_resistance != current->max_resistance ||
+				previous->min_resistance != current->min_resistance ||
+				previous->max_inertial_resistance != current->max_inertial_resistance ||
+				previous->min_inertial_resistance != current->min_inertial_resistance ||
+				previous->reference_porosity != current->reference_porosity;
+
+	// a raster tabulates clamped values, so it must be rebuilt for a new clamp
+	if (GEOMETRY || (CLAMP && current->vsi_raster_spacing > 0))
+		return GOB_PARAMS_ALL;
+
+	if (CLAMP)
+		return GOB_PARAMS_CLAMP | GOB_PARAMS_POROSITY | GOB_PARAMS_RESISTANCE;
+
+	if (POROSITY)
+		return GOB_PARAMS_POROSITY | GOB_PARAMS_RESISTANCE;
+
+	return RESISTANCE ? GOB_PARAMS_RESISTANCE : 0;
+}
+
+uint64_t gob_params_hash(const struct gob_params *params)
+{
+	uint64_t hash = HASH_INIT;
+	const unsigned char *bytes = (const unsigned char *)params;
+
+	// gob_params_load zeroes the padding, so every byte is meaningful
+	for (size_t i = 0; i < sizeof(*params); ++i)
+		hash = hash_word(hash, bytes[i]);
+
+	return hash;
+}
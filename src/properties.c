@@ -0,0 +1,21 @@
+/**
+ * @file properties.c
+ *
+ * @brief Gob property settings.
+ */
+
+#include "properties.h"
+
+void gob_property_model_init(struct gob_property_model *model, const struct gob_params *params)
+{
+	model->max_porosity = params->max_porosity;
+	model->initial_porosity = params->initial_porosity;
+	model->resist_scaler = params->resist_scaler;
+	model->max_resistance = params->max_resistance;
+	model->min_resistance = params->min_resistance;
+	model->max_inertial_resistance = params->max_inertial_resistance;
+	model->min_inertial_resistance = params->min_inertial_resistance;
+	model->initial_permeability = Initial_Perm(params->reference_porosity);
+	model->initial_inertia_resistance = Initial_Inertia_Resistance(params->reference_porosity);
+	model->single_precision = params->single_precision;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file property_export.c
+ *
+ * @brief Static property export, see property_export.h.
+ */
+
+#include <stdio.h>
+
+#include "property_export.h"
+
+/* values per message and per write burst */
+#define CHUNK 4096
+
+#define N_COLUMNS (ND_ND + 3)
+
+static const char *const COLUMN_NAMES[N_COLUMNS] = {
+	"x",
+	"y",
+#if RP_3D
+	"z",
+#endif
+	"porosity",
+	"viscous-resistance",
+	"inertial-resistance",
+};
+
+/* user-defined-memory slot of each property column */
+static const int PROPERTY_UDMS[3] = { 1, 0, 5 };
+
+/* values of one column on their way to node zero's file */
+struct column_chunk {
+	FILE *file; // node zero only, NULL if it could not be opened
+	real values[CHUNK];
+	int n;
+};
+
+static real column_value(const cell_t c, Thread *t, const int column)
+{
+	if (column < ND_ND) {
+		real x[ND_ND];
+
+		C_CENTROID(x, c, t);
+		return x[column];
+	}
+
+	return C_UDMI(c, t, PROPERTY_UDMS[column - ND_ND]);
+}
+
+static void write_values(FILE *file, const real *values, const int n)
+{
+	if (file)
+		for (int i = 0; i < n; ++i)
+			fprintf(file, "%.9g\n", (double)values[i]);
+}
+
+/* writes the chunk (node zero) or sends it to node zero */
+static void flush(struct column_chunk *chunk)
+{
+#if RP_NODE
+	if (!I_AM_NODE_ZERO_P) {
+		if (chunk->n > 0)
+			PRF_CSEND_REAL(node_zero, chunk->values, chunk->n, myid);
+
+		chunk->n = 0;
+		return;
+	}
+#endif
+
+	write_values(chunk->file, chunk->values, chunk->n);
+	chunk->n = 0;
+}
+
+#if RP_NODE
+/* node zero: the column of every other node, in node order, chunked as flush sends it */
+static void receive_column(struct column_chunk *chunk)
+{
+	int node;
+
+	compute_node_loop_not_zero(node)
+	{
+		int n;
+
+		PRF_CRECV_INT(node, &n, 1, node);
+
+		for (int left = n; left > 0; left -= CHUNK) {
+			const int N_CHUNK = left < CHUNK ? left : CHUNK;
+
+			PRF_CRECV_REAL(node, chunk->values, N_CHUNK, node);
+			write_values(chunk->file, chunk->values, N_CHUNK);
+		}
+	}
+}
+#endif
+
+/* zone exported already for an earlier role */
+static bool exported_before(const struct gob_options *options, const int role)
+{
+	for (int earlier = 0; earlier < role; ++earlier)
+		if (options->zone_ids[earlier] == options->zone_ids[role])
+			return true;
+
+	return false;
+}
+
+bool gob_properties_export(Domain *d, const struct gob_options *options)
+{
+	static struct column_chunk chunk; // kept off the stack
+	FILE *file = I_AM_NODE_ZERO_P ? fopen(GOB_PROPERTY_FILE, "w") : NULL;
+
+	chunk.file = file;
+	chunk.n = 0;
+
+	// every node takes part in every exchange, even when node zero could not open the file
+	for (int role = 0; role < GOB_N_ROLES; ++role) {
+		const int ID = options->zone_ids[role];
+
+		if (ID < 0 || exported_before(options, role))
+			continue;
+
+		Thread *t = NULL;
+		Thread *tt;
+
+		thread_loop_c(tt, d)
+		{
+			if (THREAD_ID(tt) == ID)
+				t = tt;
+		}
+
+		int n = t ? THREAD_N_ELEMENTS_INT(t) : 0;
+		const int N_TOTAL = PRF_GISUM1(n);
+
+		if (N_TOTAL == 0)
+			continue;
+
+		if (file)
+			fprintf(file, "((gob-%d point %d)\n", ID, N_TOTAL);
+
+		for (int column = 0; column < N_COLUMNS; ++column) {
+			if (file)
+				fprintf(file, "(%s\n", COLUMN_NAMES[column]);
+
+#if RP_NODE
+			if (!I_AM_NODE_ZERO_P)
+				PRF_CSEND_INT(node_zero, &n, 1, myid);
+#endif
+
+			if (t) {
+				cell_t c;
+
+				begin_c_loop_int(c, t)
+				{
+					chunk.values[chunk.n++] = column_value(c, t, column);
+
+					if (chunk.n == CHUNK)
+						flush(&chunk);
+				}
+				end_c_loop_int(c, t);
+			}
+
+			flush(&chunk);
+
+#if RP_NODE
+			if (I_AM_NODE_ZERO_P)
+				receive_column(&chunk);
+#endif
+
+			if (file)
+				fprintf(file, ")\n");
+		}
+
+		if (file)
+			fprintf(file, ")\n");
+	}
+
+	if (!I_AM_NODE_ZERO_P)
+		return true;
+
+	if (!file)
+		return false;
+
+	const bool WRITTEN = !ferror(file);
+
+	return fclose(file) == 0 && WRITTEN;
+}
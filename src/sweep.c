@@ -0,0 +1,352 @@
+/**
+ * @file sweep.c
+ *
+ * @brief Property sweep over variants of the porosity settings.
+ */
+
+#include <math.h> // for INFINITY, NAN, isnan
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h> // for strtod
+#include <string.h> // for memcpy, memset, strchr, strcmp, strtok
+
+#include "egz.h" // for EGZ_EXPLOSIVE
+#include "properties.h" // for gob_porosity_of, gob_resistances_scaled
+#include "sweep.h"
+
+#define GOB_SWEEP_FILE "longwallgobs-sweep.csv"
+#define GOB_SWEEP_MAGIC "GOBSWEEP"
+
+/* porosity, viscous and inertial resistance */
+#define N_FIELDS 3
+
+/* reals summed per variant: the volume-weighted fields and the explosive volume */
+#define N_VARIANT_SUMS (N_FIELDS + 1)
+
+#if !RP_NODE
+/* storage of a variant's setting, NULL for an unknown name */
+static real *setting(struct gob_sweep *sweep, const char *name, const int v)
+{
+	if (!strcmp(name, "max_vsi"))
+		return &sweep->max_vsi[v];
+
+	if (!strcmp(name, "max_porosity"))
+		return &sweep->max_porosity[v];
+
+	if (!strcmp(name, "initial_porosity"))
+		return &sweep->initial_porosity[v];
+
+	if (!strcmp(name, "resist_scaler"))
+		return &sweep->resist_scaler[v];
+
+	return NULL;
+}
+
+/* parses one line; returns an error message or NULL */
+static const char *parse_line(struct gob_sweep *sweep, char *line)
+{
+	char *comment = strchr(line, '#');
+	if (comment)
+		*comment = '\0';
+
+	const char *keyword = strtok(line, " \t\r\n");
+
+	if (!keyword)
+		return NULL;
+
+	if (strcmp(keyword, "variant"))
+		return "unknown keyword";
+
+	if (sweep->n == GOB_SWEEP_MAX)
+		return "too many variants";
+
+	const int V = sweep->n;
+
+	sweep->max_vsi[V] = NAN;
+	sweep->max_porosity[V] = NAN;
+	sweep->initial_porosity[V] = NAN;
+	sweep->resist_scaler[V] = NAN;
+
+	for (char *token = strtok(NULL, " \t\r\n"); token; token = strtok(NULL, " \t\r\n")) {
+		char *equals = strchr(token, '=');
+		char *end;
+
+		if (!equals)
+			return "expected name=value";
+
+		*equals = '\0';
+
+		real *value = setting(sweep, token, V);
+
+		if (!value)
+			return "unknown setting";
+
+		*value = strtod(equals + 1, &end);
+
+		if (end == equals + 1 || *end != '\0')
+			return "expected a number";
+	}
+
+	++sweep->n;
+	return NULL;
+}
+
+static bool parse_sweep(struct gob_sweep *sweep, const char *file_name)
+{
+	FILE *file = fopen(file_name, "r");
+
+	if (!file) {
+		Message("Sweep: cannot open %s\n", file_name);
+		return false;
+	}
+
+	char line[1024];
+	const char *error = NULL;
+	int line_number = 0;
+
+	while (!error && fgets(line, sizeof(line), file)) {
+		++line_number;
+		error = parse_line(sweep, line);
+	}
+
+	fclose(file);
+
+	if (!error && sweep->n == 0) {
+		error = "needs at least one variant";
+		line_number = 0;
+	}
+
+	if (error) {
+		Message("Sweep: %s:%d: %s\n", file_name, line_number, error);
+		return false;
+	}
+
+	Message("Sweep: %d variants from %s\n", sweep->n, file_name);
+	return true;
+}
+#endif // !RP_NODE
+
+bool gob_sweep_load(struct gob_sweep *sweep)
+{
+	memset(sweep, 0, sizeof(*sweep));
+
+#if !RP_NODE
+	const char *FILE_NAME =
+		RP_Variable_Exists_P("longwallgobs/sweep_file") ? RP_Get_String("longwallgobs/sweep_file") : "";
+
+	if (FILE_NAME[0] == '\0')
+		Message("Sweep: no sweep file set\n");
+	else if (!parse_sweep(sweep, FILE_NAME))
+		sweep->n = 0;
+#endif
+
+#if PARALLEL
+	// one message with every variant; NAN stays NAN
+	real buffer[1 + 4 * GOB_SWEEP_MAX];
+
+	buffer[0] = sweep->n;
+	memcpy(buffer + 1, sweep->max_vsi, sizeof(sweep->max_vsi));
+	memcpy(buffer + 1 + GOB_SWEEP_MAX, sweep->max_porosity, sizeof(sweep->max_porosity));
+	memcpy(buffer + 1 + 2 * GOB_SWEEP_MAX, sweep->initial_porosity, sizeof(sweep->initial_porosity));
+	memcpy(buffer + 1 + 3 * GOB_SWEEP_MAX, sweep->resist_scaler, sizeof(sweep->resist_scaler));
+
+	host_to_node_real(buffer, 1 + 4 * GOB_SWEEP_MAX);
+
+#if RP_NODE
+	sweep->n = (int)buffer[0];
+	memcpy(sweep->max_vsi, buffer + 1, sizeof(sweep->max_vsi));
+	memcpy(sweep->max_porosity, buffer + 1 + GOB_SWEEP_MAX, sizeof(sweep->max_porosity));
+	memcpy(sweep->initial_porosity, buffer + 1 + 2 * GOB_SWEEP_MAX, sizeof(sweep->initial_porosity));
+	memcpy(sweep->resist_scaler, buffer + 1 + 3 * GOB_SWEEP_MAX, sizeof(sweep->resist_scaler));
+#endif
+#endif // PARALLEL
+
+	return sweep->n > 0;
+}
+
+#if !RP_HOST
+static const char *const FIELD_NAMES[N_FIELDS] = { "porosity", "viscous_resistance", "inertial_resistance" };
+
+static real or_default(const real value, const real fallback)
+{
+	return isnan(value) ? fallback : value;
+}
+
+/*
+	Every variant of one cell: the clamp of clamp_vsi, then gob_porosity_of
+	and gob_resistances_scaled with the variant's settings, on values rounded
+	to real as the UDMs store them. A variant equal to the computed settings
+	reproduces udm-1, 0 and 5 exactly, in double and in float32.
+*/
+static void evaluate(const struct gob_sweep *variants, const struct gob_property_model *model, const real raw_vsi,
+		     real out[N_FIELDS][GOB_SWEEP_MAX])
+{
+	for (int v = 0; v < variants->n; ++v) {
+		const real VSI = clamp(raw_vsi, 0, variants->max_vsi[v]);
+		const real POROSITY = gob_porosity_of(VSI, variants->max_porosity[v], variants->initial_porosity[v]);
+		real viscous, inertial;
+
+		gob_resistances_scaled(model, POROSITY, variants->resist_scaler[v], &viscous, &inertial);
+
+		out[0][v] = POROSITY;
+		out[1][v] = viscous;
+		out[2][v] = inertial;
+	}
+}
+
+static void fields_file_name(char *name, const size_t size)
+{
+#if PARALLEL
+	snprintf(name, size, "longwallgobs-sweep-%d.fields", myid);
+#else
+	snprintf(name, size, "longwallgobs-sweep.fields");
+#endif
+}
+
+static bool write_header(FILE *file, Domain *d, const int n_variants)
+{
+	Thread *t;
+	uint32_t header[3] = { sizeof(real), (uint32_t)n_variants, 0 };
+
+	thread_loop_c(t, d)
+	{
+		++header[2];
+	}
+
+	return fwrite(GOB_SWEEP_MAGIC, 8, 1, file) == 1 && fwrite(header, sizeof(header), 1, file) == 1;
+}
+
+static void write_csv(FILE *file, const struct gob_sweep *variants, const real *sums, const real *low,
+		      const real *high, const bool explosive_mix)
+{
+	const int N = variants->n;
+	const real VOLUME = sums[N_VARIANT_SUMS * GOB_SWEEP_MAX];
+
+	fprintf(file, "variant,max_vsi,max_porosity,initial_porosity,resist_scaler,volume");
+
+	for (int f = 0; f < N_FIELDS; ++f)
+		fprintf(file, ",%s_mean,%s_min,%s_max", FIELD_NAMES[f], FIELD_NAMES[f], FIELD_NAMES[f]);
+
+	fprintf(file, ",explosive_volume\n");
+
+	for (int v = 0; v < N; ++v) {
+		fprintf(file, "%d,%.9g,%.9g,%.9g,%.9g,%.9g", v, (double)variants->max_vsi[v],
+			(double)variants->max_porosity[v], (double)variants->initial_porosity[v],
+			(double)variants->resist_scaler[v], (double)VOLUME);
+
+		for (int f = 0; f < N_FIELDS; ++f)
+			fprintf(file, ",%.9g,%.9g,%.9g", (double)(sums[N_VARIANT_SUMS * v + f] / VOLUME),
+				(double)low[N_FIELDS * v + f], (double)high[N_FIELDS * v + f]);
+
+		// blank without up-to-date explosive gas zones
+		if (explosive_mix)
+			fprintf(file, ",%.9g\n", (double)sums[N_VARIANT_SUMS * v + N_FIELDS]);
+		else
+			fprintf(file, ",\n");
+	}
+}
+
+bool gob_sweep_run(Domain *d, const struct gob_sweep *sweep, const struct gob_params *params,
+		   const bool explosive_mix)
+{
+	// the computed settings fill in what a variant leaves out
+	struct gob_property_model model;
+	struct gob_sweep variants = *sweep;
+
+	gob_property_model_init(&model, params);
+
+	for (int v = 0; v < variants.n; ++v) {
+		variants.max_vsi[v] = or_default(variants.max_vsi[v], params->max_vsi);
+		variants.max_porosity[v] = or_default(variants.max_porosity[v], params->max_porosity);
+		variants.initial_porosity[v] = or_default(variants.initial_porosity[v], params->initial_porosity);
+		variants.resist_scaler[v] = or_default(variants.resist_scaler[v], params->resist_scaler);
+	}
+
+	// per variant the sums, then the total volume; every reduction covers the whole arrays
+	real sums[N_VARIANT_SUMS * GOB_SWEEP_MAX + 1];
+	real low[N_FIELDS * GOB_SWEEP_MAX];
+	real high[N_FIELDS * GOB_SWEEP_MAX];
+
+	memset(sums, 0, sizeof(sums));
+
+	for (int i = 0; i < N_FIELDS * GOB_SWEEP_MAX; ++i) {
+		low[i] = INFINITY;
+		high[i] = -INFINITY;
+	}
+
+	char name[64];
+	fields_file_name(name, sizeof(name));
+
+	FILE *file = fopen(name, "wb");
+	bool ok = file && write_header(file, d, variants.n);
+
+	Thread *t;
+	cell_t c;
+
+	thread_loop_c(t, d)
+	{
+		const int32_t ids[2] = { THREAD_ID(t), THREAD_N_ELEMENTS(t) };
+		ok = ok && fwrite(ids, sizeof(ids), 1, file) == 1;
+
+		begin_c_loop(c, t)
+		{
+			real out[N_FIELDS][GOB_SWEEP_MAX];
+
+			evaluate(&variants, &model, C_UDMI(c, t, 6), out);
+
+			for (int f = 0; f < N_FIELDS; ++f)
+				ok = ok && fwrite(out[f], sizeof(real), variants.n, file) == (size_t)variants.n;
+
+			// the statistics count interior cells only; exterior cells belong to another node
+			if (c < THREAD_N_ELEMENTS_INT(t)) {
+				const real VOLUME = C_VOLUME(c, t);
+				const bool EXPLOSIVE = explosive_mix && (int)C_UDMI(c, t, 7) == EGZ_EXPLOSIVE;
+
+				sums[N_VARIANT_SUMS * GOB_SWEEP_MAX] += VOLUME;
+
+				for (int v = 0; v < variants.n; ++v) {
+					for (int f = 0; f < N_FIELDS; ++f) {
+						const real VALUE = out[f][v];
+
+						sums[N_VARIANT_SUMS * v + f] += VOLUME * VALUE;
+
+						if (VALUE < low[N_FIELDS * v + f])
+							low[N_FIELDS * v + f] = VALUE;
+
+						if (VALUE > high[N_FIELDS * v + f])
+							high[N_FIELDS * v + f] = VALUE;
+					}
+
+					// the explosive marker (udm-3) this variant would store
+					if (EXPLOSIVE)
+						sums[N_VARIANT_SUMS * v + N_FIELDS] += VOLUME * (1 - out[0][v]);
+				}
+			}
+		}
+		end_c_loop(c, t);
+	}
+
+	if (file)
+		ok = (fclose(file) == 0) && ok;
+
+#if RP_NODE
+	// three reductions for all variants and fields
+	real work[N_VARIANT_SUMS * GOB_SWEEP_MAX + 1];
+
+	PRF_GRSUM(sums, N_VARIANT_SUMS * GOB_SWEEP_MAX + 1, work);
+	PRF_GRLOW(low, N_FIELDS * GOB_SWEEP_MAX, work);
+	PRF_GRHIGH(high, N_FIELDS * GOB_SWEEP_MAX, work);
+#endif
+
+	if (!I_AM_NODE_ZERO_P)
+		return ok;
+
+	FILE *csv = fopen(GOB_SWEEP_FILE, "w");
+	if (!csv)
+		return false;
+
+	write_csv(csv, &variants, sums, low, high, explosive_mix);
+
+	return (fclose(csv) == 0) && ok;
+}
+#endif // !RP_HOST
@@ -0,0 +1,43 @@
+/**
+ * @file totals.c
+ *
+ * @brief Domain-wide totals of the gob fields.
+ */
+
+#include <math.h> // for INFINITY
+
+#include "totals.h"
+
+void gob_totals_compute(struct gob_totals *totals, Domain *d)
+{
+	Thread *t;
+	cell_t c;
+
+	int n_cells = 0;
+	real volume = 0;
+	real min_vsi = INFINITY;
+	real max_vsi = -INFINITY;
+
+	thread_loop_c(t, d)
+	{
+		begin_c_loop_int(c, t)
+		{
+			const real VSI = C_UDMI(c, t, 4);
+
+			++n_cells;
+			volume += C_VOLUME(c, t);
+
+			if (VSI < min_vsi)
+				min_vsi = VSI;
+
+			if (VSI > max_vsi)
+				max_vsi = VSI;
+		}
+		end_c_loop_int(c, t);
+	}
+
+	totals->n_cells = PRF_GISUM1(n_cells);
+	totals->volume = PRF_GRSUM1(volume);
+	totals->min_vsi = PRF_GRLOW1(min_vsi);
+	totals->max_vsi = PRF_GRHIGH1(max_vsi);
+}
@@ -4,116 +4,337 @@
 
 #include "udf.h" // Fluent macros
 
+#include "adaption.h"
+#include "cache.h"
+#include "explosive_log.h"
+#include "fits_batch.h"
+#include "flammability.h"
+#include "omp_loop.h"
+#include "panel_frame.h"
+#include "params.h"
+#include "property_export.h"
+#include "sweep.h"
+#include "totals.h"
 #include "udf_vsi.h"
 #include "udf_explosive_mix.h"
-#include "udf_inertia.h"
-#include "udf_permeability.h"
-#include "udf_porosity.h"
+#include "udf_properties.h"
 #include "utils.h"
+#include "zone_bounds.h"
+#include "zone_stats.h"
 
 #define domain_ID 2 // using primary phase domain
 
 int ite = 0; // number of iterations elapsed; for global use in UDF definitions
+int gob_omp_threads = 1; // OpenMP threads per compute node for the cell loops
 
 DEFINE_PROFILE(set_poro_VSI, t, nv)
 {
-	define_poro_1();
+	publish_gob_property(1);
 }
 
+#if !RP_HOST
+static bool track_explosive_volume = false; // explosive gas zones enabled at the last udf_main run
+
+/* adaptive schedule of the explosive gas zone updates, in iterations (steady) or timesteps (transient) */
+static int egz_max_interval = 1; // longest allowed interval
+static real egz_tolerance = 0; // relative volume change that still counts as stable
+static int egz_interval = 1; // current interval
+static int egz_countdown = 1; // steps left until the next update
+static real egz_volume = 0; // explosive volume at the last update
+
+/* reclassifies the gas mixture, then logs the total explosive volume */
+static real update_explosive_volume(void)
+{
+	const real EXPLOSIVE_VOLUME = PRF_GRSUM1(calc_explosive_mix());
+
+	gob_explosive_log_append(N_ITER, CURRENT_TIME, EXPLOSIVE_VOLUME);
+
+	return EXPLOSIVE_VOLUME;
+}
+
+static struct gob_params computed_params; // parameters the current fields were computed from
+static struct gob_options computed_options; // run settings the current fields were computed with
+static uint64_t computed_fields = 0; // hash of the fields as computed (0 = never computed)
+static uint64_t mapped_frame = 0; // panel frame key of the cell coordinates in udm-8/9 (0 = never mapped)
+
+/* gives the cells an adaption added since the fields were computed the fields
+   of the others; every node must call it */
+static void refresh_adapted_cells(Domain *d)
+{
+	const uint64_t SHAPE = gob_mesh_shape(d);
+	const bool ADAPTED = computed_fields != 0 && SHAPE != computed_params.mesh_shape;
+
+	if (!PRF_GIHIGH1(ADAPTED))
+		return;
+
+	// cells without the panel coordinates of these fields count as new, so
+	// an unmapped mesh (fields from the cache) is refreshed as a whole
+	const int N_NEW = ADAPTED ? gob_adaption_refresh(d, &computed_params) : 0;
+
+	if (PRF_GIHIGH1(N_NEW < 0)) {
+		Message0("Adaption: new cells not computed, click OK to recompute all fields\n");
+		computed_fields = 0;
+		return;
+	}
+
+	if (ADAPTED) {
+		computed_params.mesh_shape = SHAPE;
+		mapped_frame = gob_panel_frame_key(&computed_params);
+		computed_fields = gob_fields_hash(d);
+	}
+
+	// classify the new cells at the end of this step
+	egz_countdown = 1;
+
+	Message0("Adaption: computed VSI and gob properties of %d new cells\n", PRF_GISUM1(N_NEW));
+}
+#endif
+
 DEFINE_ADJUST(demo_calc, d)
 {
 	++ite;
+
+#if !RP_HOST
+	refresh_adapted_cells(d);
+#endif
+}
+
+DEFINE_EXECUTE_AT_END(update_explosive_zones)
+{
+#if !RP_HOST
+	if (!track_explosive_volume || --egz_countdown > 0)
+		return;
+
+	// the volume is globally reduced, so every node picks the same interval
+	const real VOLUME = update_explosive_volume();
+
+	// double the interval while the volume holds steady, back to every step once it moves
+	if (fabs(VOLUME - egz_volume) > egz_tolerance * fabs(egz_volume))
+		egz_interval = 1;
+	else if (2 * egz_interval < egz_max_interval)
+		egz_interval *= 2;
+	else
+		egz_interval = egz_max_interval;
+
+	egz_countdown = egz_interval;
+	egz_volume = VOLUME;
+#endif
 }
 
 DEFINE_PROFILE(set_inertia_1_VSI, t, nv)
 {
-	define_inertia_1();
+	publish_gob_property(5);
 }
 
 DEFINE_PROFILE(set_inertia_2_VSI, t, nv)
 {
-	define_inertia_2();
+	publish_gob_property(5);
 }
 
 DEFINE_PROFILE(set_inertia_3_VSI, t, nv)
 {
-	define_inertia_3();
+	publish_gob_property(5);
 }
 
 DEFINE_PROFILE(set_perm_1_VSI, t, nv)
 {
-	define_permeability_1();
+	publish_gob_property(0);
 }
 
 DEFINE_PROFILE(set_perm_2_VSI, t, nv)
 {
-	define_permeability_2();
+	publish_gob_property(0);
 }
 
 DEFINE_PROFILE(set_perm_3_VSI, t, nv)
 {
-	define_permeability_3();
+	publish_gob_property(0);
 }
 
 DEFINE_EXECUTE_FROM_GUI(udf_main, longwallgobs, mode)
 {
-	// if not set to default -1, we are using a single part mesh
-	const bool SINGLE_PART_MESH = RP_Get_Integer("longwallgobs/single_part_mesh_id") >= 0;
-
-	// get FLAC3D offsets
-	real panel_x_offset = 0;
-	real panel_y_offset = 0;
-
-	if (SINGLE_PART_MESH) {
-		// midpoint of working face center
-		panel_x_offset = (RP_Get_Real("longwallgobs/single_part_mesh_max_x") +
-				  RP_Get_Real("longwallgobs/single_part_mesh_min_x")) /
-				 2;
-
-		// assumption: startup room MORE POSITIVE than working face
-		panel_y_offset = RP_Get_Real("longwallgobs/single_part_mesh_max_y");
-	} else if (RP_Get_Boolean("mine_t")) {
-		if (RP_Get_Real("longwallgobs/startup_room_corner_max_y") >
-		    RP_Get_Real("longwallgobs/working_face_corner_max_y")) {
-			panel_x_offset = RP_Get_Real("longwallgobs/working_face_corner_min_x");
-			panel_y_offset = RP_Get_Real("longwallgobs/startup_room_corner_max_y");
-		} else {
-			panel_x_offset = RP_Get_Real("longwallgobs/working_face_corner_max_x");
-			panel_y_offset = RP_Get_Real("longwallgobs/startup_room_corner_min_y");
+	Domain *d = Get_Domain(1);
+
+	// the host reads every setting once and broadcasts them to the nodes
+	struct gob_params params;
+	struct gob_options options;
+	gob_params_load(&params, &options, d);
+
+	// the split of the cell loops does not change any result, so it is not a parameter
+	gob_omp_threads = options.omp_threads;
+
+	// multi-component flammability limits, if a data file is given
+	flam_load(&gob_flammability);
+
+#if !RP_HOST
+	Message0("panel_x_offset: %f\npanel_y_offset: %f\n", params.panel_x_offset, params.panel_y_offset);
+
+	// cells an adaption added since the last run first catch up with the
+	// others, unless the new settings recompute every cell anyway
+	struct gob_params adapted_params = computed_params;
+	adapted_params.mesh_shape = params.mesh_shape;
+
+	if (!PRF_GIHIGH1((int)(gob_params_diff(&adapted_params, &params) & GOB_PARAMS_GEOMETRY)))
+		refresh_adapted_cells(d);
+
+	// only recompute what the changed settings feed; fields changed behind our
+	// back (initialization, data file read) are recomputed from scratch
+	unsigned stale = GOB_PARAMS_ALL;
+
+	if (computed_fields != 0 && gob_fields_hash(d) == computed_fields)
+		stale = gob_params_diff(&computed_params, &params);
+	else
+		mapped_frame = 0;
+
+	// every node must take the same branches below; the stale sets are nested,
+	// so the largest one over all nodes is their union
+	stale = (unsigned)PRF_GIHIGH1((int)stale);
+
+	// reload VSI + properties if nothing they depend on has changed
+	uint64_t cache_key = 0;
+
+	if (stale && options.cache_fields) {
+		cache_key = gob_cache_key(d, &params);
+
+		// recompute everywhere unless every node found its file
+		if (PRF_GILOW1(gob_cache_load(d, cache_key))) {
+			Message0("Loaded VSI and gob properties from cache\n");
+			stale = 0;
 		}
-	} else {
-		// midpoint of working face center
-		panel_x_offset = (RP_Get_Real("longwallgobs/working_face_center_max_x") +
-				  RP_Get_Real("longwallgobs/working_face_center_min_x")) /
-				 2;
-
-		// working face->startup room along positive y-axis
-		if (RP_Get_Real("longwallgobs/startup_room_center_max_y") >
-		    RP_Get_Real("longwallgobs/working_face_center_max_y"))
-			panel_y_offset = RP_Get_Real("longwallgobs/startup_room_center_max_y");
-
-		// working face->startup room along negative y-axis
-		else
-			panel_y_offset = RP_Get_Real("longwallgobs/startup_room_center_min_y");
+	} else if (!stale) {
+		Message0("VSI and gob properties are up to date\n");
+	}
+
+	if (stale & GOB_PARAMS_GEOMETRY) {
+		// the cell coordinates outlive mine model and zone layout changes
+		const uint64_t FRAME = gob_panel_frame_key(&params);
+
+		if (!PRF_GILOW1(FRAME == mapped_frame)) {
+			Message0("Mapping cells to the panel frame...\n");
+			vsi_panel_coords(&params);
+			mapped_frame = FRAME;
+		}
+
+		Message0("Calculating VSI...\n");
+
+		// calculate vsi
+		if (params.mine_c)
+			vsi_mine_C_stepped(&params);
+
+		if (params.mine_e)
+			vsi_mine_E_stepped(&params);
+
+		if (params.mine_t)
+			vsi_trona_stepped(&params);
+
+		// the faster fit tiers report what they cost against the exact fits
+		const double FIT_ERROR = PRF_GRHIGH1(fits_batch_precision_error());
+
+		if (params.fit_precision != FITS_PRECISION_EXACT)
+			Message0("Fit precision %d: sampled error %g of max(|fit|, 1) against the exact fits\n",
+				 params.fit_precision, FIT_ERROR);
+	} else if (stale & GOB_PARAMS_CLAMP) {
+		Message0("Clamping VSI...\n");
+		clamp_vsi(&params);
+	}
+
+	// porosity, viscous + inertial resistance from the vsi, published by the profiles
+	if (stale & (GOB_PARAMS_POROSITY | GOB_PARAMS_RESISTANCE))
+		calc_gob_properties(&params, stale & GOB_PARAMS_POROSITY);
+
+	if (stale && options.cache_fields && PRF_GILOW1(gob_cache_save(d, cache_key)))
+		Message0("Saved VSI and gob properties to cache\n");
+
+	computed_params = params;
+	computed_options = options;
+	computed_fields = gob_fields_hash(d);
+
+	struct gob_totals totals;
+	gob_totals_compute(&totals, d);
+
+	Message0("Cells: %d (%g m^3), VSI from %g to %g\n", totals.n_cells, totals.volume, totals.min_vsi,
+		 totals.max_vsi);
+
+	// calculate explosive gas mix + integral, then keep them updated during the solve
+	track_explosive_volume = options.explosive_mix;
+	egz_max_interval = options.egz_max_interval > 1 ? options.egz_max_interval : 1;
+	egz_tolerance = options.egz_tolerance;
+	egz_interval = 1;
+	egz_countdown = 1;
+
+	if (options.explosive_mix) {
+		egz_volume = update_explosive_volume();
+		Message0("Explosive gas volume: %g m^3\n", egz_volume);
+	}
+#endif // !RP_HOST
+}
+
+DEFINE_ON_DEMAND(measure_zone_bounds)
+{
+	// the zone selection and the panel angle come from the GUI, the rest of the snapshot goes unused
+	struct gob_params params;
+	struct gob_options options;
+
+	gob_params_load(&params, &options, Get_Domain(1));
+
+	gob_zone_bounds_measure(Get_Domain(1), &params, &options);
+}
+
+DEFINE_ON_DEMAND(write_zone_stats)
+{
+#if !RP_HOST
+	// the zone ids and field ranges come from the last udf_main run
+	if (computed_fields == 0) {
+		Message0("Zone statistics: no gob fields computed yet\n");
+		return;
 	}
 
-	printf("panel_x_offset: %f\npanel_y_offset: %f\n", panel_x_offset, panel_y_offset);
+	if (PRF_GILOW1(gob_zone_stats_write(Get_Domain(1), &computed_params, &computed_options,
+					    track_explosive_volume)))
+		Message0("Wrote zone statistics to longwallgobs-zones.json\n");
+	else
+		Message0("Zone statistics: could not write longwallgobs-zones.json\n");
+#endif
+}
 
-	printf("Calculating VSI...\n");
+DEFINE_ON_DEMAND(export_gob_properties)
+{
+#if !RP_HOST
+	// the fields and zones of the last udf_main run, bound as fixed properties by the GUI
+	if (computed_fields == 0) {
+		Message0("Property export: no gob fields computed yet\n");
+		return;
+	}
 
-	// calculate vsi
-	if (RP_Get_Boolean("mine_c"))
-		vsi_mine_C_stepped(SINGLE_PART_MESH, panel_x_offset, panel_y_offset);
+	if (PRF_GILOW1(gob_properties_export(Get_Domain(1), &computed_options)))
+		Message0("Wrote the gob properties to " GOB_PROPERTY_FILE "\n");
+	else
+		Message0("Property export: could not write " GOB_PROPERTY_FILE "\n");
+#endif
+}
 
-	if (RP_Get_Boolean("mine_e"))
-		vsi_mine_E_stepped(SINGLE_PART_MESH, panel_x_offset, panel_y_offset);
+DEFINE_ON_DEMAND(sweep_gob_properties)
+{
+	// the host reads the sweep file and broadcasts the variants
+	struct gob_sweep sweep;
 
-	if (RP_Get_Boolean("mine_t"))
-		vsi_trona_stepped(SINGLE_PART_MESH, panel_x_offset, panel_y_offset);
+	if (!gob_sweep_load(&sweep))
+		return;
 
-	// calculate explosive gas mix + integral
-	if (RP_Get_Boolean("longwallgobs/egz_radio_button")) {
-		calc_explosive_mix();
-		calc_explosive_integral_gob();
+#if !RP_HOST
+	// the variants start from the VSI of the last udf_main run
+	if (computed_fields == 0) {
+		Message0("Sweep: no gob fields computed yet\n");
+		return;
 	}
+
+	if (computed_params.vsi_raster_spacing > 0)
+		Message0("Sweep: the VSI raster is clamped to max_vsi %g, larger variant values have no effect\n",
+			 computed_params.max_vsi);
+
+	if (PRF_GILOW1(gob_sweep_run(Get_Domain(1), &sweep, &computed_params, track_explosive_volume)))
+		Message0("Wrote %d property variants to longwallgobs-sweep.csv and the .fields files\n", sweep.n);
+	else
+		Message0("Sweep: could not write the results\n");
+#endif
 }
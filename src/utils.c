@@ -1,6 +1,7 @@
 #include <math.h> // for fabs
+#include <string.h> // for memcpy
 
-#include "utils.h" // Fluent macros
+#include "utils.h"
 
 double Cell_Inertia_Resistance(double cellporo, double initial_inertia_resistance)
 {
@@ -15,33 +16,23 @@ C2 = C2_inital * (1-n)/n^3
 	return (initial_inertia_resistance * (1.0000000 - cellporo) / (cellporo * cellporo * cellporo));
 }
 
-double Initial_Inertia_Resistance()
+double Initial_Inertia_Resistance(double initial_porosity)
 {
 	/* C2_initial=3.5/Dp * (1-n)/n^3
 	Dp is the mean particle diameter, and n is porosity (%)
 	mean particle diameter from Pappas & Mark 1993 = 0.2 meters, Kozeny constant 180.  */
 
-	double initial_porosity = 0.2577800000000;
-	if (RP_Variable_Exists_P("vsi/initial-poroisty")) { /* Returns true if the variable exists */
-		initial_porosity = (RP_Get_Double("vsi/initial-porosity"));
-	}
-
 	return (3.5 / 0.2000000 * (1.000000000000 - initial_porosity) /
 		(initial_porosity * initial_porosity * initial_porosity));
 }
 
-double Initial_Perm()
+double Initial_Perm(double initial_porosity)
 {
 	/* K_o=n^3 /(180 * (1-n)^2) * d^2
 	where K_o is permeability (miliDarcies), n is porosity (%)
 	and d is the mean particle diameter (meters).
 	mean particle diameter from Pappas & Mark 1993 = 0.2 meters, Kozeny constant 180.  */
 
-	double initial_porosity = 0.2577800000000;
-	if (RP_Variable_Exists_P("vsi/initial-poroisty")) { /* Returns true if the variable exists */
-		initial_porosity = (RP_Get_Double("vsi/initial-porosity"));
-	}
-
 	return (initial_porosity * initial_porosity * initial_porosity /
 		(180.0000000000 * (1.0000000000 - initial_porosity) * (1.000000000 - initial_porosity)) *
 		0.20000000000 * 0.20000000000);
@@ -67,17 +58,15 @@ bool fequal(const double num1, const double num2)
 	return fabs(num2 - num1) < 1e-6;
 }
 
-double clamp_positive(const double num)
+uint64_t hash_word(uint64_t hash, const uint64_t word)
 {
-	return (num < 0) ? 0 : num;
+	hash ^= word;
+	return hash * 0x100000001b3ull;
 }
 
-double clamp(const double num, const double min, const double max)
+uint64_t hash_double(const uint64_t hash, const double value)
 {
-	if (num < min)
-		return min;
-	if (num > max)
-		return max;
-
-	return num;
+	uint64_t word;
+	memcpy(&word, &value, sizeof(word));
+	return hash_word(hash, word);
 }
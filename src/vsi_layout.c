@@ -0,0 +1,120 @@
+/**
+ * @file vsi_layout.c
+ *
+ * @brief Zone layouts of the stepped VSI surfaces.
+ */
+
+#include <math.h> // for fabs
+#include <string.h> // for memset
+
+#include "vsi_layout.h"
+
+/* extent of a zone along the panel (y) */
+static real zone_length(const struct gob_zone_bounds *zone)
+{
+	return fabs(zone->max_y - zone->min_y);
+}
+
+/* extent of a zone across the panel (x) */
+static real zone_width(const struct gob_zone_bounds *zone)
+{
+	return fabs(zone->max_x - zone->min_x);
+}
+
+void vsi_trona_layout(struct vsi_layout *layout, const struct gob_params *params)
+{
+	real panel_half_width, panel_length;
+
+	memset(layout, 0, sizeof(*layout));
+
+	if (params->single_part_mesh) {
+		panel_half_width = zone_width(&params->single_part_mesh_bounds) / 2;
+		panel_length = zone_length(&params->single_part_mesh_bounds);
+
+		layout->BOX[3] = VSI_TRONA_SINGLE_PART_BOX_3;
+		layout->BOX[4] = panel_length - 400;
+	} else {
+		const real startup_corner_length = zone_length(&params->startup_room_corner);
+		const real mid_panel_gateroad_length = zone_length(&params->mid_panel_gateroad);
+		const real working_face_corner_length = zone_length(&params->working_face_corner);
+
+		panel_half_width = zone_width(&params->startup_room_corner);
+		panel_length = startup_corner_length + mid_panel_gateroad_length + working_face_corner_length;
+
+		layout->BOX[3] = startup_corner_length;
+		layout->BOX[4] = startup_corner_length + mid_panel_gateroad_length;
+	}
+
+	layout->BOX[1] = panel_half_width;
+	layout->BOX[5] = panel_length;
+
+	layout->half_width = layout->BOX[1];
+	layout->length = layout->BOX[5];
+	layout->classify = vsi_trona_classify;
+	layout->stepped_n = params->single_part_mesh ? vsi_trona_single_part_stepped_n : vsi_trona_stepped_n;
+	layout->at = vsi_trona_stepped_at;
+}
+
+/* mines C and E share the super critical panel layout */
+static void super_critical_layout(struct vsi_layout *layout, const struct gob_params *params)
+{
+	real panel_half_width, panel_length;
+
+	memset(layout, 0, sizeof(*layout));
+
+	if (params->single_part_mesh) {
+		panel_half_width = zone_width(&params->single_part_mesh_bounds) / 2;
+		panel_length = zone_length(&params->single_part_mesh_bounds);
+
+		layout->BOX[1] = panel_half_width - 100;
+		layout->BOX[4] = VSI_SUPER_CRITICAL_SINGLE_PART_BOX_4;
+		layout->BOX[5] = panel_length - 300;
+	} else {
+		const real startup_corner_length = zone_length(&params->startup_room_corner);
+		const real mid_panel_gateroad_length = zone_length(&params->mid_panel_gateroad);
+		const real working_face_corner_width = zone_width(&params->working_face_corner);
+		const real working_face_corner_length = zone_length(&params->working_face_corner);
+		const real working_face_center_width = zone_width(&params->working_face_center);
+
+		panel_half_width = working_face_corner_width + working_face_center_width / 2;
+		panel_length = startup_corner_length + mid_panel_gateroad_length + working_face_corner_length;
+
+		layout->BOX[1] = working_face_center_width / 2;
+		layout->BOX[4] = startup_corner_length;
+		layout->BOX[5] = startup_corner_length + mid_panel_gateroad_length;
+	}
+
+	layout->BOX[2] = panel_half_width;
+	layout->BOX[6] = panel_length;
+
+	layout->half_width = layout->BOX[2];
+	layout->length = layout->BOX[6];
+}
+
+void vsi_mine_C_layout(struct vsi_layout *layout, const struct gob_params *params)
+{
+	super_critical_layout(layout, params);
+	layout->classify = vsi_mine_C_classify;
+	layout->stepped_n = params->single_part_mesh ? vsi_mine_C_single_part_stepped_n : vsi_mine_C_stepped_n;
+	layout->at = vsi_mine_C_stepped_at;
+}
+
+void vsi_mine_E_layout(struct vsi_layout *layout, const struct gob_params *params)
+{
+	super_critical_layout(layout, params);
+	layout->classify = vsi_mine_E_classify;
+	layout->stepped_n = params->single_part_mesh ? vsi_mine_E_single_part_stepped_n : vsi_mine_E_stepped_n;
+	layout->at = vsi_mine_E_stepped_at;
+}
+
+vsi_layout_fn vsi_layout_of(const struct gob_params *params)
+{
+	// same order as udf_main, so the last selected one wins
+	if (params->mine_t)
+		return vsi_trona_layout;
+
+	if (params->mine_e)
+		return vsi_mine_E_layout;
+
+	return params->mine_c ? vsi_mine_C_layout : NULL;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file vsi_raster.c
+ *
+ * @brief Tabulated VSI surface over a whole panel, sampled bilinearly.
+ */
+
+#include <math.h> // for ceil, fabs
+#include <stdlib.h>
+
+#include "udf.h" // for Message0
+
+#include "vsi_raster.h"
+
+/* the clamped surface, which is all the cells ever see */
+static double clamped(vsi_point_fn vsi_at, const double x_loc, const double y_loc, const double *BOX,
+		      const double max_vsi)
+{
+	const double VSI = vsi_at(x_loc, y_loc, BOX);
+
+	return VSI < 0 ? 0 : (VSI > max_vsi ? max_vsi : VSI);
+}
+
+/* refuse grids above this many nodes (~512 MB of doubles) */
+#define VSI_RASTER_MAX_NODES (64L * 1024 * 1024)
+
+/* bilinear interpolation of the raster cell (i, j) at fractional offsets (fx, fy) */
+static double interpolate(const struct vsi_raster *raster, const int i, const int j, const double fx,
+			  const double fy)
+{
+	const double *row0 = raster->values + (long)j * raster->nx;
+	const double *row1 = row0 + raster->nx;
+
+	const double bottom = row0[i] + fx * (row0[i + 1] - row0[i]);
+	const double top = row1[i] + fx * (row1[i + 1] - row1[i]);
+
+	return bottom + fy * (top - bottom);
+}
+
+bool vsi_raster_build(struct vsi_raster *raster, vsi_point_fn vsi_at, const double *BOX, const double width,
+		      const double length, const double spacing, const double max_vsi)
+{
+	*raster = (struct vsi_raster){ 0 };
+
+	if (!(width > 0) || !(length > 0) || !(spacing > 0))
+		return false;
+
+	// at least one raster cell each way, nodes on both panel edges
+	const long NX = (long)ceil(width / spacing) + 1;
+	const long NY = (long)ceil(length / spacing) + 1;
+
+	if (NX * NY > VSI_RASTER_MAX_NODES) {
+		Message0("VSI raster: %ld x %ld nodes is too fine, evaluating per cell instead\n", NX, NY);
+		return false;
+	}
+
+	raster->values = malloc(NX * NY * sizeof(*raster->values));
+	if (!raster->values)
+		return false;
+
+	raster->nx = (int)NX;
+	raster->ny = (int)NY;
+	raster->width = width;
+	raster->length = length;
+
+	const double DX = width / (NX - 1);
+	const double DY = length / (NY - 1);
+
+	raster->inv_dx = 1 / DX;
+	raster->inv_dy = 1 / DY;
+
+	for (long j = 0; j < NY; ++j)
+		for (long i = 0; i < NX; ++i)
+			raster->values[j * NX + i] = clamped(vsi_at, i * DX, j * DY, BOX, max_vsi);
+
+	// the surface has kinks/steps at zone and blend boundaries; measure the
+	// worst interpolation error where bilinear sampling is least accurate
+	double err_x = 0, err_y = 0;
+
+	for (long j = 0; j + 1 < NY; ++j) {
+		for (long i = 0; i + 1 < NX; ++i) {
+			const double X = (i + 0.5) * DX;
+			const double Y = (j + 0.5) * DY;
+			const double ERROR =
+				fabs(interpolate(raster, i, j, 0.5, 0.5) - clamped(vsi_at, X, Y, BOX, max_vsi));
+
+			if (ERROR > raster->max_error) {
+				raster->max_error = ERROR;
+				err_x = X;
+				err_y = Y;
+			}
+		}
+	}
+
+	Message0("VSI raster: %d x %d nodes (%.3g m x %.3g m spacing), max interpolation error %.3g at x_loc = %.1f m, y_loc = %.1f m\n",
+	         raster->nx, raster->ny, DX, DY, raster->max_error, err_x, err_y);
+
+	return true;
+}
+
+double vsi_raster_sample(const struct vsi_raster *raster, const double x_loc, const double y_loc)
+{
+	// the stepped surfaces are zero outside the panel
+	if (x_loc > raster->width || y_loc > raster->length || y_loc < 0)
+		return 0;
+
+	const double U = x_loc * raster->inv_dx;
+	const double V = y_loc * raster->inv_dy;
+
+	// clamp to the last raster cell so the panel edges stay in bounds
+	int i = (int)U;
+	int j = (int)V;
+
+	if (i > raster->nx - 2)
+		i = raster->nx - 2;
+	if (j > raster->ny - 2)
+		j = raster->ny - 2;
+
+	return interpolate(raster, i, j, U - i, V - j);
+}
+
+void vsi_raster_free(struct vsi_raster *raster)
+{
+	free(raster->values);
+	*raster = (struct vsi_raster){ 0 };
+}
@@ -0,0 +1,690 @@
+/**
+ * @file vsi_stepped.c
+ *
+ * @brief Piecewise (stepped + blended) VSI surfaces of all three mine models.
+ * Each zone is normalized to the coordinate space of its fit; neighbouring
+ * fits are linearly blended across the zone boundaries.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "vsi_stepped.h"
+#include "fits.h" // for equation fits
+#include "fits_batch.h" // for batched equation fits
+
+/* forced inlining, so each specialized kernel gets its own copy of the classifier */
+#if defined(__GNUC__)
+#define STEPPED_INLINE static inline __attribute__((always_inline))
+#else
+#define STEPPED_INLINE static inline
+#endif
+
+/* FIT TABLES *****************************************************************/
+
+/* the trona gateroad fit is the only one of x alone */
+static double trona_mid_panel_gateroad_xy(const double x, const double y)
+{
+	(void)y;
+
+	return sub_critical_trona_mid_panel_gateroad(x);
+}
+
+static void trona_mid_panel_gateroad_xy_n(const double *x, const double *y, double *out, const int n)
+{
+	(void)y;
+
+	sub_critical_trona_mid_panel_gateroad_n(x, out, n);
+}
+
+static double (*const FIT_SCALAR[VSI_FIT_COUNT])(const double, const double) = {
+	[VSI_FIT_TRONA_WORKING_FACE_CORNER] = sub_critical_trona_working_face_corner,
+	[VSI_FIT_TRONA_MID_PANEL_GATEROAD] = trona_mid_panel_gateroad_xy,
+	[VSI_FIT_TRONA_STARTUP_ROOM_CORNER] = sub_critical_trona_startup_room_corner,
+	[VSI_FIT_E_STARTUP_ROOM_CENTER] = super_critical_mine_E_startup_room_center,
+	[VSI_FIT_E_MID_PANEL_CENTER] = super_critical_mine_E_mid_panel_center,
+	[VSI_FIT_E_WORKING_FACE_CENTER] = super_critical_mine_E_working_face_center,
+	[VSI_FIT_E_WORKING_FACE_CORNER] = super_critical_mine_E_working_face_corner,
+	[VSI_FIT_E_STARTUP_ROOM_CORNER] = super_critical_mine_E_startup_room_corner,
+	[VSI_FIT_E_MID_PANEL_GATEROAD] = super_critical_mine_E_mid_panel_gateroad,
+	[VSI_FIT_C_STARTUP_ROOM_CENTER] = super_critical_mine_C_startup_room_center,
+	[VSI_FIT_C_MID_PANEL_CENTER] = super_critical_mine_C_mid_panel_center,
+	[VSI_FIT_C_WORKING_FACE_CENTER] = super_critical_mine_C_working_face_center,
+	[VSI_FIT_C_WORKING_FACE_CORNER] = super_critical_mine_C_working_face_corner,
+	[VSI_FIT_C_STARTUP_ROOM_CORNER] = super_critical_mine_C_startup_room_corner,
+	[VSI_FIT_C_MID_PANEL_GATEROAD] = super_critical_mine_C_mid_panel_gateroad,
+};
+
+static void (*const FIT_BATCH[VSI_FIT_COUNT])(const double *, const double *, double *, const int) = {
+	[VSI_FIT_TRONA_WORKING_FACE_CORNER] = sub_critical_trona_working_face_corner_n,
+	[VSI_FIT_TRONA_MID_PANEL_GATEROAD] = trona_mid_panel_gateroad_xy_n,
+	[VSI_FIT_TRONA_STARTUP_ROOM_CORNER] = sub_critical_trona_startup_room_corner_n,
+	[VSI_FIT_E_STARTUP_ROOM_CENTER] = super_critical_mine_E_startup_room_center_n,
+	[VSI_FIT_E_MID_PANEL_CENTER] = super_critical_mine_E_mid_panel_center_n,
+	[VSI_FIT_E_WORKING_FACE_CENTER] = super_critical_mine_E_working_face_center_n,
+	[VSI_FIT_E_WORKING_FACE_CORNER] = super_critical_mine_E_working_face_corner_n,
+	[VSI_FIT_E_STARTUP_ROOM_CORNER] = super_critical_mine_E_startup_room_corner_n,
+	[VSI_FIT_E_MID_PANEL_GATEROAD] = super_critical_mine_E_mid_panel_gateroad_n,
+	[VSI_FIT_C_STARTUP_ROOM_CENTER] = super_critical_mine_C_startup_room_center_n,
+	[VSI_FIT_C_MID_PANEL_CENTER] = super_critical_mine_C_mid_panel_center_n,
+	[VSI_FIT_C_WORKING_FACE_CENTER] = super_critical_mine_C_working_face_center_n,
+	[VSI_FIT_C_WORKING_FACE_CORNER] = super_critical_mine_C_working_face_corner_n,
+	[VSI_FIT_C_STARTUP_ROOM_CORNER] = super_critical_mine_C_startup_room_corner_n,
+	[VSI_FIT_C_MID_PANEL_GATEROAD] = super_critical_mine_C_mid_panel_gateroad_n,
+};
+
+const char *const VSI_FIT_NAMES[VSI_FIT_COUNT] = {
+	[VSI_FIT_TRONA_WORKING_FACE_CORNER] = "sub_critical_trona_working_face_corner",
+	[VSI_FIT_TRONA_MID_PANEL_GATEROAD] = "sub_critical_trona_mid_panel_gateroad",
+	[VSI_FIT_TRONA_STARTUP_ROOM_CORNER] = "sub_critical_trona_startup_room_corner",
+	[VSI_FIT_E_STARTUP_ROOM_CENTER] = "super_critical_mine_E_startup_room_center",
+	[VSI_FIT_E_MID_PANEL_CENTER] = "super_critical_mine_E_mid_panel_center",
+	[VSI_FIT_E_WORKING_FACE_CENTER] = "super_critical_mine_E_working_face_center",
+	[VSI_FIT_E_WORKING_FACE_CORNER] = "super_critical_mine_E_working_face_corner",
+	[VSI_FIT_E_STARTUP_ROOM_CORNER] = "super_critical_mine_E_startup_room_corner",
+	[VSI_FIT_E_MID_PANEL_GATEROAD] = "super_critical_mine_E_mid_panel_gateroad",
+	[VSI_FIT_C_STARTUP_ROOM_CENTER] = "super_critical_mine_C_startup_room_center",
+	[VSI_FIT_C_MID_PANEL_CENTER] = "super_critical_mine_C_mid_panel_center",
+	[VSI_FIT_C_WORKING_FACE_CENTER] = "super_critical_mine_C_working_face_center",
+	[VSI_FIT_C_WORKING_FACE_CORNER] = "super_critical_mine_C_working_face_corner",
+	[VSI_FIT_C_STARTUP_ROOM_CORNER] = "super_critical_mine_C_startup_room_corner",
+	[VSI_FIT_C_MID_PANEL_GATEROAD] = "super_critical_mine_C_mid_panel_gateroad",
+};
+
+double vsi_fit(const int fit, const double x, const double y)
+{
+	return FIT_SCALAR[fit](x, y);
+}
+
+void vsi_fit_n(const int fit, const double *x, const double *y, double *out, const int n)
+{
+	FIT_BATCH[fit](x, y, out, n);
+}
+
+/* SAMPLES ********************************************************************/
+
+static void outside(struct vsi_sample *sample)
+{
+	sample->region = VSI_REGION_OUTSIDE;
+}
+
+static void pure(struct vsi_sample *sample, const int fit, const double x, const double y)
+{
+	sample->region = VSI_REGION_PURE;
+	sample->fit[0] = fit;
+	sample->x[0] = x;
+	sample->y[0] = y;
+}
+
+/* F(fit_0)(x_0, y_0) * blend_mix + F(fit_1)(x_1, y_1) * (1 - blend_mix) */
+static void blend(struct vsi_sample *sample, const int region, const int fit_0, const double x_0, const double y_0,
+		  const int fit_1, const double x_1, const double y_1, const double blend_mix)
+{
+	sample->region = region;
+	sample->fit[0] = fit_0;
+	sample->x[0] = x_0;
+	sample->y[0] = y_0;
+	sample->fit[1] = fit_1;
+	sample->x[1] = x_1;
+	sample->y[1] = y_1;
+	sample->blend = blend_mix;
+}
+
+/* VSI of a classified point from its fit values (fun_1 unused unless blended) */
+static double combine(const struct vsi_sample *sample, const double fun_0, const double fun_1)
+{
+	switch (sample->region) {
+	case VSI_REGION_PURE:
+		return fun_0;
+	case VSI_REGION_BLEND_X:
+	case VSI_REGION_BLEND_Y:
+		// linearly interpolate
+		return fun_0 * sample->blend + fun_1 * (1 - sample->blend);
+	default:
+		return 0;
+	}
+}
+
+/* VSI of a classified point, evaluating its fits one at a time */
+static double evaluate(const struct vsi_sample *sample)
+{
+	if (sample->region == VSI_REGION_OUTSIDE)
+		return 0;
+
+	const double FUN_0 = FIT_SCALAR[sample->fit[0]](sample->x[0], sample->y[0]);
+
+	if (sample->region == VSI_REGION_PURE)
+		return combine(sample, FUN_0, 0);
+
+	return combine(sample, FUN_0, FIT_SCALAR[sample->fit[1]](sample->x[1], sample->y[1]));
+}
+
+/* TRONA MINE *****************************************************************/
+
+STEPPED_INLINE void trona_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	const double BLEND_RANGE_Y = 25; // (half) width of the blend zone
+
+	// limit vsi function to only within panel domain sizing
+	if (x_loc > BOX[1] || y_loc > BOX[5]) {
+		outside(sample);
+	} else if (y_loc < BOX[3] - BLEND_RANGE_Y) {
+		// normalize to equation
+		x_loc = -(x_loc - BOX[1]) / BOX[1];
+		y_loc = y_loc / BOX[5];
+
+		pure(sample, VSI_FIT_TRONA_STARTUP_ROOM_CORNER, x_loc, y_loc);
+	} else if (y_loc < BOX[3] + BLEND_RANGE_Y) {
+		// normalize to equation
+		x_loc = -(x_loc - BOX[1]) / BOX[1];
+		y_loc = y_loc / BOX[5];
+
+		// calculate blending factor
+		const double BLEND_MIX = -(y_loc - BOX[3] - BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);
+
+		blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_TRONA_STARTUP_ROOM_CORNER, x_loc, y_loc,
+		      VSI_FIT_TRONA_MID_PANEL_GATEROAD, x_loc, 0, BLEND_MIX);
+	} else if (y_loc < (BOX[4] - BLEND_RANGE_Y - 20)) {
+		// normalize to equation
+		x_loc = -(x_loc - BOX[1]) / BOX[1];
+
+		pure(sample, VSI_FIT_TRONA_MID_PANEL_GATEROAD, x_loc, 0);
+	} else if (y_loc < BOX[4] + BLEND_RANGE_Y + 20) {
+		// normalize to equation
+		const double X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];
+		const double X_LOC_2 = -(x_loc - BOX[1]) / (BOX[1] + 40) + 0.02;
+		y_loc = -(y_loc - BOX[5]) / (BOX[5] - BOX[4]) + 0.012;
+
+		// calculate blending factor
+		const double BLEND_MIX = -(y_loc - BOX[4] - BLEND_RANGE_Y - 20) / (2 * BLEND_RANGE_Y + 40);
+
+		blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_TRONA_MID_PANEL_GATEROAD, X_LOC_1, 0,
+		      VSI_FIT_TRONA_WORKING_FACE_CORNER, X_LOC_2, y_loc, BLEND_MIX);
+	} else {
+		// normalize to equation
+		x_loc = -(x_loc - BOX[1]) / (BOX[1] + 40) + 0.02;
+		y_loc = -(y_loc - BOX[5]) / (BOX[5] - BOX[4]) + 0.012;
+
+		pure(sample, VSI_FIT_TRONA_WORKING_FACE_CORNER, x_loc, y_loc);
+	}
+}
+
+void vsi_trona_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	trona_classify(x_loc, y_loc, BOX, sample);
+}
+
+/* MINE C *********************************************************************/
+
+STEPPED_INLINE void mine_C_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	const double BLEND_RANGE = 15;
+	const double BLEND_RANGE_Y = 25; // (half) width of the blend zone
+
+	// limit vsi function to only within panel domain sizing
+	if (x_loc > BOX[2] || y_loc < 0) {
+		outside(sample);
+	} else if (x_loc < BOX[1] - BLEND_RANGE) {
+		if (y_loc < BOX[4] - BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			x_loc = -(x_loc - BOX[1] + 20) / BOX[1];
+			y_loc = y_loc / BOX[4];
+
+			pure(sample, VSI_FIT_C_STARTUP_ROOM_CENTER, x_loc, y_loc);
+		} else if (y_loc < BOX[4] + BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / (BOX[1]);
+			const double X_LOC_2 = -(x_loc - BOX[1]) / BOX[1];
+			const double Y_LOC_1 = BOX[4];
+			const double Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+			// calculate blending factor
+			const double BLEND_MIX = (y_loc - BLEND_RANGE_Y - 15) / (2 * BLEND_RANGE_Y + 30);
+
+			blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_C_MID_PANEL_CENTER, X_LOC_2, Y_LOC_2,
+			      VSI_FIT_C_STARTUP_ROOM_CENTER, X_LOC_1, Y_LOC_1, BLEND_MIX);
+		} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			x_loc = (-(x_loc - BOX[1] + 10) / (BOX[1]));
+			y_loc = ((y_loc - BOX[4]) / (BOX[5] - BOX[4]));
+
+			pure(sample, VSI_FIT_C_MID_PANEL_CENTER, x_loc, y_loc);
+		} else if (y_loc < BOX[5] + BLEND_RANGE_Y + 15) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];
+			const double X_LOC_2 = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];
+			const double Y_LOC_1 = (y_loc - BOX[4] - 100) / (BOX[5] - BOX[4]);
+			const double Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+			// calculate blending factor
+			const double BLEND_MIX = -(y_loc - BOX[5] - BLEND_RANGE_Y - 15) / (2 * BLEND_RANGE_Y + 30);
+
+			blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_C_MID_PANEL_CENTER, X_LOC_1, Y_LOC_1,
+			      VSI_FIT_C_WORKING_FACE_CENTER, X_LOC_2, Y_LOC_2, BLEND_MIX);
+		} else if (y_loc < BOX[6]) {
+			// normalize to equation
+			x_loc = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];
+			y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+			pure(sample, VSI_FIT_C_WORKING_FACE_CENTER, x_loc, y_loc);
+		} else {
+			outside(sample);
+		}
+	} else if (x_loc <= BOX[1] + BLEND_RANGE) {
+		// calculate blending factor
+		const double BLEND_MIX = (x_loc - BOX[1] + BLEND_RANGE) / (2 * BLEND_RANGE);
+
+		if (y_loc < BOX[4]) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];
+			const double X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+			y_loc /= BOX[4];
+
+			blend(sample, VSI_REGION_BLEND_X, VSI_FIT_C_STARTUP_ROOM_CORNER, X_LOC_2, y_loc,
+			      VSI_FIT_C_STARTUP_ROOM_CENTER, X_LOC_1, y_loc, BLEND_MIX);
+		} else if (y_loc <= BOX[5]) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];
+			const double X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+			y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+			blend(sample, VSI_REGION_BLEND_X, VSI_FIT_C_MID_PANEL_GATEROAD, X_LOC_2, y_loc,
+			      VSI_FIT_C_MID_PANEL_CENTER, X_LOC_1, y_loc, BLEND_MIX);
+		} else if (y_loc < BOX[6]) {
+			// normalize to equation
+			const double X_LOC_1 = (x_loc - (BOX[1] - BLEND_RANGE)) / (BOX[1] + BLEND_RANGE);
+			const double X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+			y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+			blend(sample, VSI_REGION_BLEND_X, VSI_FIT_C_WORKING_FACE_CORNER, X_LOC_2, y_loc,
+			      VSI_FIT_C_WORKING_FACE_CENTER, X_LOC_1, y_loc, BLEND_MIX);
+		} else {
+			outside(sample);
+		}
+	} else if (y_loc < BOX[4] - BLEND_RANGE_Y) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		y_loc /= BOX[4];
+
+		pure(sample, VSI_FIT_C_STARTUP_ROOM_CORNER, x_loc, y_loc);
+	} else if (y_loc < BOX[4] + BLEND_RANGE_Y) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		const double Y_LOC_1 = y_loc / BOX[4];
+		const double Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+		// calculate blending factor
+		const double BLEND_MIX = (y_loc - BOX[4] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);
+
+		blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_C_MID_PANEL_GATEROAD, x_loc, Y_LOC_2,
+		      VSI_FIT_C_STARTUP_ROOM_CORNER, x_loc, Y_LOC_1, BLEND_MIX);
+	} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 20) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+		pure(sample, VSI_FIT_C_MID_PANEL_GATEROAD, x_loc, y_loc);
+	} else if (y_loc < BOX[5] + BLEND_RANGE_Y + 20) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		const double Y_LOC_1 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+		const double Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+		// calculate blending factor
+		const double BLEND_MIX = ((y_loc - BOX[5] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y));
+
+		blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_C_WORKING_FACE_CORNER, x_loc, Y_LOC_2,
+		      VSI_FIT_C_MID_PANEL_GATEROAD, x_loc, Y_LOC_1, BLEND_MIX);
+	} else if (y_loc < BOX[6]) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+		pure(sample, VSI_FIT_C_WORKING_FACE_CORNER, x_loc, y_loc);
+	} else {
+		outside(sample);
+	}
+}
+
+void vsi_mine_C_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	mine_C_classify(x_loc, y_loc, BOX, sample);
+}
+
+/* MINE E *********************************************************************/
+
+STEPPED_INLINE void mine_E_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	const double BLEND_RANGE = 20;
+	const double BLEND_RANGE_Y = 20; // (half) width of the blend zone
+
+	// limit vsi function to only within panel domain sizing
+	if (x_loc > BOX[2] || y_loc < 0) {
+		outside(sample);
+	} else if (x_loc < BOX[1] - BLEND_RANGE) {
+		if (y_loc < BOX[4] - BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			x_loc = -(x_loc - BOX[1] + 20) / BOX[1];
+			y_loc /= BOX[4];
+
+			pure(sample, VSI_FIT_E_STARTUP_ROOM_CENTER, x_loc, y_loc);
+		} else if (y_loc < BOX[4] + BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1] + 20) / BOX[1];
+			const double X_LOC_2 = -(x_loc - BOX[1] + 10) / BOX[1];
+			const double Y_LOC_1 = y_loc / BOX[4];
+			const double Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+			// calculate blending factor
+			const double BLEND_MIX = (y_loc - (BOX[4] + BLEND_RANGE_Y - 15)) / (2 * BLEND_RANGE_Y);
+
+			blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_E_MID_PANEL_CENTER, X_LOC_2, Y_LOC_2,
+			      VSI_FIT_E_STARTUP_ROOM_CENTER, X_LOC_1, Y_LOC_1, BLEND_MIX);
+		} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			x_loc = -(x_loc - BOX[1] + 10) / BOX[1];
+			y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+			pure(sample, VSI_FIT_E_MID_PANEL_CENTER, x_loc, y_loc);
+		} else if (y_loc < BOX[5] + BLEND_RANGE_Y - 15) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];
+			const double X_LOC_2 = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];
+			const double Y_LOC_1 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+			const double Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+			// calculate blending factor
+			const double BLEND_MIX = -((y_loc - (BOX[5] + BLEND_RANGE_Y - 15)) / (2 * BLEND_RANGE_Y));
+
+			blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_E_MID_PANEL_CENTER, X_LOC_1, Y_LOC_1,
+			      VSI_FIT_E_WORKING_FACE_CENTER, X_LOC_2, Y_LOC_2, BLEND_MIX);
+		} else if (y_loc < BOX[6]) {
+			// normalize to equation
+			x_loc = (x_loc - BOX[1] + BLEND_RANGE + 15) / BOX[1];
+			y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+			pure(sample, VSI_FIT_E_WORKING_FACE_CENTER, x_loc, y_loc);
+		} else {
+			outside(sample);
+		}
+	} else if (x_loc <= BOX[1] + BLEND_RANGE) {
+		// calculate blending factor
+		const double BLEND_MIX = (x_loc - BOX[1] + BLEND_RANGE) / (2 * BLEND_RANGE);
+
+		if (y_loc < BOX[4]) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / BOX[1];
+			const double X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+			y_loc /= BOX[4];
+
+			blend(sample, VSI_REGION_BLEND_X, VSI_FIT_E_STARTUP_ROOM_CORNER, X_LOC_2, y_loc,
+			      VSI_FIT_E_STARTUP_ROOM_CENTER, X_LOC_1, y_loc, BLEND_MIX);
+		} else if (y_loc <= BOX[5]) {
+			// normalize to equation
+			const double X_LOC_1 = -(x_loc - BOX[1]) / (BOX[1]);
+			const double X_LOC_2 = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+			y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+			blend(sample, VSI_REGION_BLEND_X, VSI_FIT_E_MID_PANEL_GATEROAD, X_LOC_2, y_loc,
+			      VSI_FIT_E_MID_PANEL_CENTER, X_LOC_1, y_loc, BLEND_MIX);
+		} else if (y_loc < BOX[6]) {
+			// normalize to equation
+			const double X_LOC_1 = (x_loc - (BOX[1])) / (BOX[1]);
+			const double X_LOC_2 = 1 - (x_loc - (BOX[1])) / (BOX[2] - BOX[1]);
+			y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+			blend(sample, VSI_REGION_BLEND_X, VSI_FIT_E_WORKING_FACE_CORNER, X_LOC_2, y_loc,
+			      VSI_FIT_E_WORKING_FACE_CENTER, X_LOC_1, y_loc, BLEND_MIX);
+		} else {
+			outside(sample);
+		}
+	} else if (y_loc < BOX[4] - BLEND_RANGE_Y) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		y_loc /= BOX[4];
+
+		pure(sample, VSI_FIT_E_STARTUP_ROOM_CORNER, x_loc, y_loc);
+	} else if (y_loc < BOX[4] + BLEND_RANGE_Y) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		const double Y_LOC_1 = y_loc / BOX[4];
+		const double Y_LOC_2 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+		// calculate blending factor
+		const double BLEND_MIX = (y_loc - BOX[4] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);
+
+		blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_E_MID_PANEL_GATEROAD, x_loc, Y_LOC_2,
+		      VSI_FIT_E_STARTUP_ROOM_CORNER, x_loc, Y_LOC_1, BLEND_MIX);
+	} else if (y_loc < BOX[5] - BLEND_RANGE_Y - 20) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		y_loc = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+
+		pure(sample, VSI_FIT_E_MID_PANEL_GATEROAD, x_loc, y_loc);
+	} else if (y_loc < BOX[5] + BLEND_RANGE_Y + 20) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		const double Y_LOC_1 = (y_loc - BOX[4]) / (BOX[5] - BOX[4]);
+		const double Y_LOC_2 = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+		// calculate blending factor
+		const double BLEND_MIX = (y_loc - BOX[5] + BLEND_RANGE_Y) / (2 * BLEND_RANGE_Y);
+
+		blend(sample, VSI_REGION_BLEND_Y, VSI_FIT_E_WORKING_FACE_CORNER, x_loc, Y_LOC_2,
+		      VSI_FIT_E_MID_PANEL_GATEROAD, x_loc, Y_LOC_1, BLEND_MIX);
+	} else if (y_loc < BOX[6]) {
+		// normalize to equation
+		x_loc = 1 - (x_loc - BOX[1]) / (BOX[2] - BOX[1]);
+		y_loc = 1 - (y_loc - BOX[5]) / (BOX[6] - BOX[5]);
+
+		pure(sample, VSI_FIT_E_WORKING_FACE_CORNER, x_loc, y_loc);
+	} else {
+		outside(sample);
+	}
+}
+
+void vsi_mine_E_classify(double x_loc, double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	mine_E_classify(x_loc, y_loc, BOX, sample);
+}
+
+/* POINT EVALUATION ***********************************************************/
+
+double vsi_trona_stepped_at(double x_loc, double y_loc, const double *BOX)
+{
+	struct vsi_sample sample;
+
+	vsi_trona_classify(x_loc, y_loc, BOX, &sample);
+
+	return evaluate(&sample);
+}
+
+double vsi_mine_C_stepped_at(double x_loc, double y_loc, const double *BOX)
+{
+	struct vsi_sample sample;
+
+	vsi_mine_C_classify(x_loc, y_loc, BOX, &sample);
+
+	return evaluate(&sample);
+}
+
+double vsi_mine_E_stepped_at(double x_loc, double y_loc, const double *BOX)
+{
+	struct vsi_sample sample;
+
+	vsi_mine_E_classify(x_loc, y_loc, BOX, &sample);
+
+	return evaluate(&sample);
+}
+
+/* BATCH EVALUATION ***********************************************************/
+
+bool vsi_batch_reserve(struct vsi_batch *batch, const int n)
+{
+	if (n <= batch->capacity)
+		return true;
+
+	struct vsi_batch grown = { .threads = batch->threads, .capacity = n };
+
+	grown.x_loc = malloc(n * sizeof(*grown.x_loc));
+	grown.y_loc = malloc(n * sizeof(*grown.y_loc));
+	grown.vsi = malloc(n * sizeof(*grown.vsi));
+	grown.samples = malloc(n * sizeof(*grown.samples));
+	grown.fit_x = malloc(2 * n * sizeof(*grown.fit_x));
+	grown.fit_y = malloc(2 * n * sizeof(*grown.fit_y));
+	grown.fit_out = malloc(2 * n * sizeof(*grown.fit_out));
+	grown.fit_ref = malloc(2 * n * sizeof(*grown.fit_ref));
+	grown.fit_value = malloc(2 * n * sizeof(*grown.fit_value));
+
+	if (!grown.x_loc || !grown.y_loc || !grown.vsi || !grown.samples || !grown.fit_x || !grown.fit_y ||
+	    !grown.fit_out || !grown.fit_ref || !grown.fit_value) {
+		vsi_batch_free(&grown);
+		return false;
+	}
+
+	vsi_batch_free(batch);
+	*batch = grown;
+
+	return true;
+}
+
+void vsi_batch_free(struct vsi_batch *batch)
+{
+	free(batch->x_loc);
+	free(batch->y_loc);
+	free(batch->vsi);
+	free(batch->samples);
+	free(batch->fit_x);
+	free(batch->fit_y);
+	free(batch->fit_out);
+	free(batch->fit_ref);
+	free(batch->fit_value);
+
+	*batch = (struct vsi_batch){ .threads = batch->threads };
+}
+
+/* fit evaluations a classified point needs */
+static int fit_slots(const struct vsi_sample *sample)
+{
+	switch (sample->region) {
+	case VSI_REGION_PURE:
+		return 1;
+	case VSI_REGION_BLEND_X:
+	case VSI_REGION_BLEND_Y:
+		return 2;
+	default:
+		return 0;
+	}
+}
+
+/* fit evaluations handed to one OpenMP thread at a time */
+#define FIT_CHUNK 4096
+
+/* mine model of an evaluator */
+enum stepped_mine { STEPPED_TRONA, STEPPED_MINE_C, STEPPED_MINE_E };
+
+/* classifies one point with the classifier of the mine model inlined */
+STEPPED_INLINE void classify_point(const int mine, const bool single_part_mesh, const double x_loc,
+				   const double y_loc, const double *BOX, struct vsi_sample *sample)
+{
+	// a local copy, so the startup room edge a single part mesh fixes folds in as a constant
+	double box[VSI_BOX_SIZE];
+
+	for (int k = 0; k < VSI_BOX_SIZE; ++k)
+		box[k] = BOX[k];
+
+	if (single_part_mesh && mine == STEPPED_TRONA)
+		box[3] = VSI_TRONA_SINGLE_PART_BOX_3;
+	else if (single_part_mesh)
+		box[4] = VSI_SUPER_CRITICAL_SINGLE_PART_BOX_4;
+
+	if (mine == STEPPED_TRONA)
+		trona_classify(x_loc, y_loc, box, sample);
+	else if (mine == STEPPED_MINE_C)
+		mine_C_classify(x_loc, y_loc, box, sample);
+	else
+		mine_E_classify(x_loc, y_loc, box, sample);
+}
+
+/* passes 2 and 3 of every evaluator: runs each fit over the classified points that need it, then blends */
+static void evaluate_samples(struct vsi_batch *batch, const int n)
+{
+	const struct vsi_sample *samples = batch->samples;
+
+	// group the fit evaluations by fit (counting sort, in point order)
+	int offset[VSI_FIT_COUNT + 1] = { 0 };
+	int next[VSI_FIT_COUNT];
+
+	for (int i = 0; i < n; ++i)
+		for (int slot = 0; slot < fit_slots(&samples[i]); ++slot)
+			++offset[samples[i].fit[slot] + 1];
+
+	for (int f = 0; f < VSI_FIT_COUNT; ++f) {
+		offset[f + 1] += offset[f];
+		next[f] = offset[f];
+	}
+
+	for (int i = 0; i < n; ++i) {
+		for (int slot = 0; slot < fit_slots(&samples[i]); ++slot) {
+			const int j = next[samples[i].fit[slot]]++;
+
+			batch->fit_x[j] = samples[i].x[slot];
+			batch->fit_y[j] = samples[i].y[slot];
+			batch->fit_ref[j] = 2 * i + slot;
+		}
+	}
+
+	// each fit over its whole group, in chunks (every point is
+	// evaluated independently, so the chunking does not change the results)
+	for (int f = 0; f < VSI_FIT_COUNT; ++f) {
+#pragma omp parallel for schedule(static) num_threads(batch->threads) \
+	if (batch->threads > 1 && offset[f + 1] - offset[f] > FIT_CHUNK)
+		for (int start = offset[f]; start < offset[f + 1]; start += FIT_CHUNK) {
+			const int SIZE = (offset[f + 1] - start < FIT_CHUNK) ? offset[f + 1] - start : FIT_CHUNK;
+
+			FIT_BATCH[f](batch->fit_x + start, batch->fit_y + start, batch->fit_out + start, SIZE);
+		}
+	}
+
+#pragma omp parallel for schedule(static) num_threads(batch->threads) if (batch->threads > 1)
+	for (int j = 0; j < offset[VSI_FIT_COUNT]; ++j)
+		batch->fit_value[batch->fit_ref[j]] = batch->fit_out[j];
+
+	// blend
+#pragma omp parallel for schedule(static) num_threads(batch->threads) if (batch->threads > 1)
+	for (int i = 0; i < n; ++i) {
+		const int SLOTS = fit_slots(&samples[i]);
+
+		batch->vsi[i] = combine(&samples[i], (SLOTS > 0) ? batch->fit_value[2 * i] : 0,
+					(SLOTS > 1) ? batch->fit_value[2 * i + 1] : 0);
+	}
+}
+
+void vsi_stepped_n(struct vsi_batch *batch, vsi_classify_fn classify, const double *BOX, const int n)
+{
+	// pass 1: region and fit coordinates of every point
+#pragma omp parallel for schedule(static) num_threads(batch->threads) if (batch->threads > 1)
+	for (int i = 0; i < n; ++i)
+		classify(batch->x_loc[i], batch->y_loc[i], BOX, &batch->samples[i]);
+
+	evaluate_samples(batch, n);
+}
+
+/* pass 1 per mine model and mesh mode, with the classifier inlined into the (OpenMP outlined) loop */
+#define STEPPED_N(name, mine, single_part_mesh)                                                                  \
+	void name(struct vsi_batch *batch, const double *BOX, const int n)                                       \
+	{                                                                                                        \
+		_Pragma("omp parallel for schedule(static) num_threads(batch->threads) if (batch->threads > 1)") \
+		for (int i = 0; i < n; ++i)                                                                      \
+			classify_point(mine, single_part_mesh, batch->x_loc[i], batch->y_loc[i], BOX,            \
+				       &batch->samples[i]);                                                      \
+                                                                                                                 \
+		evaluate_samples(batch, n);                                                                      \
+	}
+
+STEPPED_N(vsi_trona_stepped_n, STEPPED_TRONA, false)
+STEPPED_N(vsi_trona_single_part_stepped_n, STEPPED_TRONA, true)
+STEPPED_N(vsi_mine_C_stepped_n, STEPPED_MINE_C, false)
+STEPPED_N(vsi_mine_C_single_part_stepped_n, STEPPED_MINE_C, true)
+STEPPED_N(vsi_mine_E_stepped_n, STEPPED_MINE_E, false)
+STEPPED_N(vsi_mine_E_single_part_stepped_n, STEPPED_MINE_E, true)
@@ -0,0 +1,136 @@
+/**
+ * @file zone_bounds.c
+ *
+ * @brief Bounding boxes of the selected zones, see zone_bounds.h.
+ */
+
+#include <math.h> // for INFINITY
+#include <stdio.h> // for snprintf
+
+#include "panel_frame.h"
+#include "zone_bounds.h"
+
+/* low and high hold min x, min y and max x, max y of each role */
+#define N_BOUNDS (2 * GOB_N_ROLES)
+
+#if !RP_HOST
+/* grows the box of every role assigned to a thread by the vertices of its interior cells, along the panel axes */
+static void sweep_thread(Thread *t, const struct gob_panel_frame *frame, const struct gob_options *options,
+			 real low[N_BOUNDS], real high[N_BOUNDS])
+{
+	real min_x = INFINITY, min_y = INFINITY;
+	real max_x = -INFINITY, max_y = -INFINITY;
+	cell_t c;
+	int n;
+
+	begin_c_loop_int(c, t)
+	{
+		c_node_loop(c, t, n)
+		{
+			const Node *V = C_NODE(c, t, n);
+			double u, v;
+
+			gob_panel_frame_axes(frame, NODE_X(V), NODE_Y(V), &u, &v);
+
+			min_x = u < min_x ? u : min_x;
+			max_x = u > max_x ? u : max_x;
+			min_y = v < min_y ? v : min_y;
+			max_y = v > max_y ? v : max_y;
+		}
+	}
+	end_c_loop_int(c, t);
+
+	// a zone may be assigned to several roles
+	for (int role = 0; role < GOB_N_ROLES; ++role)
+		if (options->zone_ids[role] == THREAD_ID(t)) {
+			low[2 * role] = min_x < low[2 * role] ? min_x : low[2 * role];
+			low[2 * role + 1] = min_y < low[2 * role + 1] ? min_y : low[2 * role + 1];
+			high[2 * role] = max_x > high[2 * role] ? max_x : high[2 * role];
+			high[2 * role + 1] = max_y > high[2 * role + 1] ? max_y : high[2 * role + 1];
+		}
+}
+#endif // !RP_HOST
+
+#if !RP_NODE
+static void store(const char *role, const char *bound, const real value)
+{
+	char name[96];
+
+	snprintf(name, sizeof(name), "longwallgobs/%s_%s", role, bound);
+	RP_Set_Real(name, value);
+}
+#endif // !RP_NODE
+
+bool gob_zone_bounds_measure(Domain *d, const struct gob_params *params, const struct gob_options *options)
+{
+	real low[N_BOUNDS];
+	real high[N_BOUNDS];
+
+	for (int i = 0; i < N_BOUNDS; ++i) {
+		low[i] = INFINITY;
+		high[i] = -INFINITY;
+	}
+
+#if !RP_HOST
+	struct gob_panel_frame frame;
+	Thread *t;
+
+	gob_panel_frame_of(&frame, params);
+
+	// one pass over the selected threads only
+	thread_loop_c(t, d)
+	{
+		for (int role = 0; role < GOB_N_ROLES; ++role)
+			if (options->zone_ids[role] == THREAD_ID(t)) {
+				sweep_thread(t, &frame, options, low, high);
+				break;
+			}
+	}
+
+#if RP_NODE
+	// two reductions for all roles
+	real work[N_BOUNDS];
+
+	PRF_GRLOW(low, N_BOUNDS, work);
+	PRF_GRHIGH(high, N_BOUNDS, work);
+#endif
+#endif // !RP_HOST
+
+#if PARALLEL
+	node_to_host_real(low, N_BOUNDS);
+	node_to_host_real(high, N_BOUNDS);
+#endif
+
+	int n_selected = 0;
+	int n_measured = 0;
+
+	for (int role = 0; role < GOB_N_ROLES; ++role) {
+		if (options->zone_ids[role] < 0)
+			continue;
+
+		++n_selected;
+
+		// a zone without cells keeps its empty box
+		if (!(low[2 * role] <= high[2 * role])) {
+#if !RP_NODE
+			Message("Zone bounds: zone %d (%s) has no cells, bounds not changed\n", options->zone_ids[role],
+				GOB_ROLE_NAMES[role]);
+#endif
+			continue;
+		}
+
+#if !RP_NODE
+		store(GOB_ROLE_NAMES[role], "min_x", low[2 * role]);
+		store(GOB_ROLE_NAMES[role], "min_y", low[2 * role + 1]);
+		store(GOB_ROLE_NAMES[role], "max_x", high[2 * role]);
+		store(GOB_ROLE_NAMES[role], "max_y", high[2 * role + 1]);
+#endif
+		++n_measured;
+	}
+
+#if !RP_NODE
+	Message("Zone bounds: measured %d selected zones\n", n_measured);
+#endif
+
+	return n_measured == n_selected;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file zone_stats.c
+ *
+ * @brief Statistics of the gob fields per panel zone.
+ */
+
+#include <math.h> // for INFINITY
+#include <stdio.h>
+#include <string.h> // for memset
+
+#include "egz.h" // for EGZ_N_CLASSES
+#include "zone_stats.h"
+
+#define GOB_ZONE_STATS_FILE "longwallgobs-zones.json"
+
+/* one entry per role, plus the cells of every unassigned zone */
+#define N_ZONES (GOB_N_ROLES + 1)
+#define OTHER_ZONE GOB_N_ROLES
+
+#define N_FIELDS 4
+
+/* fields covered and the user-defined-memory slot each lives in */
+static const struct {
+	const char *name;
+	int udm;
+} FIELDS[N_FIELDS] = {
+	{ "vsi", 4 },
+	{ "porosity", 1 },
+	{ "viscous_resistance", 0 },
+	{ "inertial_resistance", 5 },
+};
+
+static const char *const EGZ_NAMES[EGZ_N_CLASSES] = {
+	[EGZ_EXPLOSIVE] = "explosive",
+	[EGZ_NEAR_EXPLOSIVE] = "near_explosive",
+	[EGZ_FUEL_RICH_INERT] = "fuel_rich_inert",
+	[EGZ_OXYGEN_LEAN_INERT_A] = "oxygen_lean_inert_a",
+	[EGZ_OXYGEN_LEAN_INERT_DARK] = "oxygen_lean_inert_dark",
+	[EGZ_OXYGEN_LEAN_INERT_B] = "oxygen_lean_inert_b",
+	[EGZ_OXYGEN_RICH_INERT] = "oxygen_rich_inert",
+	[EGZ_UNCLASSIFIED] = "unclassified",
+};
+
+/* volumes summed per zone; all doubles, so an array of these reduces as one
+   array, and a node's millions of cells do not run out of float digits */
+struct zone_sums {
+	double volume;
+	double weighted[N_FIELDS]; // sum of volume * value
+	double histogram[N_FIELDS][ZONE_STATS_N_BINS]; // volume per bin
+	double egz_volume[EGZ_N_CLASSES];
+};
+
+/* doubles in the sums of all zones */
+#define N_SUMS (N_ZONES * (int)(sizeof(struct zone_sums) / sizeof(double)))
+
+/* range each field is clamped to when computed */
+static void field_ranges(const struct gob_params *params, real low[N_FIELDS], real high[N_FIELDS])
+{
+	low[0] = 0;
+	high[0] = params->max_vsi;
+	low[1] = 0;
+	high[1] = params->max_porosity * params->initial_porosity;
+	low[2] = params->min_resistance * params->resist_scaler;
+	high[2] = params->max_resistance * params->resist_scaler;
+	low[3] = params->min_inertial_resistance * params->resist_scaler;
+	high[3] = params->max_inertial_resistance * params->resist_scaler;
+}
+
+static int histogram_bin(const real value, const real low, const real high)
+{
+	if (!(high > low))
+		return 0;
+
+	const int BIN = (int)((value - low) / (high - low) * ZONE_STATS_N_BINS);
+
+	return BIN < 0 ? 0 : (BIN >= ZONE_STATS_N_BINS ? ZONE_STATS_N_BINS - 1 : BIN);
+}
+
+/* entry of a thread: the first role it is assigned to, which also stands for
+   the later roles of the same zone (see write_roles) */
+static int zone_of(const struct gob_options *options, const int thread_id)
+{
+	for (int role = 0; role < GOB_N_ROLES; ++role)
+		if (options->zone_ids[role] == thread_id)
+			return role;
+
+	return OTHER_ZONE;
+}
+
+/* every role of the entry's zone, so a zone assigned to several roles lists them all */
+static void write_roles(FILE *file, const struct gob_options *options, const int z)
+{
+	bool first = true;
+
+	fprintf(file, "\t\t\t\"roles\": [");
+
+	for (int role = z; z != OTHER_ZONE && role < GOB_N_ROLES; ++role)
+		if (options->zone_ids[role] == options->zone_ids[z]) {
+			fprintf(file, "%s\"%s\"", first ? "" : ", ", GOB_ROLE_NAMES[role]);
+			first = false;
+		}
+
+	fprintf(file, "],\n");
+}
+
+static void write_json(FILE *file, const int cells[N_ZONES], const struct zone_sums *sums,
+		       real min[N_ZONES][N_FIELDS], real max[N_ZONES][N_FIELDS], const real low[N_FIELDS],
+		       const real high[N_FIELDS], const struct gob_options *options, const bool explosive_mix)
+{
+	fprintf(file, "{\n\t\"iteration\": %d,\n\t\"bins\": %d,\n\t\"zones\": [", N_ITER, ZONE_STATS_N_BINS);
+
+	bool first = true;
+
+	for (int z = 0; z < N_ZONES; ++z) {
+		if (cells[z] == 0)
+			continue;
+
+		fprintf(file, "%s\n\t\t{\n", first ? "" : ",");
+		first = false;
+
+		fprintf(file, "\t\t\t\"zone\": \"%s\",\n\t\t\t\"zone_id\": %d,\n",
+			z == OTHER_ZONE ? "other" : GOB_ROLE_NAMES[z], z == OTHER_ZONE ? -1 : options->zone_ids[z]);
+		write_roles(file, options, z);
+		fprintf(file, "\t\t\t\"cells\": %d,\n\t\t\t\"volume\": %.9g", cells[z], sums[z].volume);
+
+		for (int f = 0; f < N_FIELDS; ++f) {
+			fprintf(file, ",\n\t\t\t\"%s\": {\"min\": %.9g, \"max\": %.9g, \"mean\": %.9g, ", FIELDS[f].name,
+				(double)min[z][f], (double)max[z][f], sums[z].weighted[f] / sums[z].volume);
+			fprintf(file, "\"range\": [%.9g, %.9g], \"histogram\": [", (double)low[f], (double)high[f]);
+
+			for (int b = 0; b < ZONE_STATS_N_BINS; ++b)
+				fprintf(file, "%s%.9g", b ? ", " : "", sums[z].histogram[f][b]);
+
+			fprintf(file, "]}");
+		}
+
+		if (explosive_mix) {
+			fprintf(file, ",\n\t\t\t\"egz_volume\": {");
+
+			for (int k = 0; k < EGZ_N_CLASSES; ++k)
+				fprintf(file, "%s\"%s\": %.9g", k ? ", " : "", EGZ_NAMES[k], sums[z].egz_volume[k]);
+
+			fprintf(file, "}");
+		}
+
+		fprintf(file, "\n\t\t}");
+	}
+
+	fprintf(file, "\n\t]\n}\n");
+}
+
+bool gob_zone_stats_write(Domain *d, const struct gob_params *params, const struct gob_options *options,
+			  const bool explosive_mix)
+{
+	int cells[N_ZONES] = { 0 };
+	struct zone_sums sums[N_ZONES];
+	real min[N_ZONES][N_FIELDS];
+	real max[N_ZONES][N_FIELDS];
+	real low[N_FIELDS];
+	real high[N_FIELDS];
+
+	memset(sums, 0, sizeof(sums));
+	field_ranges(params, low, high);
+
+	for (int z = 0; z < N_ZONES; ++z)
+		for (int f = 0; f < N_FIELDS; ++f) {
+			min[z][f] = INFINITY;
+			max[z][f] = -INFINITY;
+		}
+
+	Thread *t;
+	cell_t c;
+
+	// one pass over every interior cell (exterior cells are another node's interior)
+	thread_loop_c(t, d)
+	{
+		const int Z = zone_of(options, THREAD_ID(t));
+		struct zone_sums *zone = &sums[Z];
+
+		begin_c_loop_int(c, t)
+		{
+			const real VOLUME = C_VOLUME(c, t);
+
+			++cells[Z];
+			zone->volume += VOLUME;
+
+			for (int f = 0; f < N_FIELDS; ++f) {
+				const real VALUE = C_UDMI(c, t, FIELDS[f].udm);
+
+				zone->weighted[f] += (double)VOLUME * VALUE;
+				zone->histogram[f][histogram_bin(VALUE, low[f], high[f])] += VOLUME;
+
+				if (VALUE < min[Z][f])
+					min[Z][f] = VALUE;
+
+				if (VALUE > max[Z][f])
+					max[Z][f] = VALUE;
+			}
+
+			if (explosive_mix) {
+				const int EGZ = (int)C_UDMI(c, t, 7);
+
+				if (EGZ >= 0 && EGZ < EGZ_N_CLASSES)
+					zone->egz_volume[EGZ] += VOLUME;
+			}
+		}
+		end_c_loop_int(c, t);
+	}
+
+#if RP_NODE
+	// four reductions for all zones and fields, the sums through a real buffer
+	int cells_work[N_ZONES];
+	real buffer[N_SUMS];
+	real work[N_SUMS];
+	double *const SUMS = (double *)sums;
+
+	for (int i = 0; i < N_SUMS; ++i)
+		buffer[i] = SUMS[i];
+
+	PRF_GISUM(cells, N_ZONES, cells_work);
+	PRF_GRSUM(buffer, N_SUMS, work);
+	PRF_GRLOW(&min[0][0], N_ZONES * N_FIELDS, work);
+	PRF_GRHIGH(&max[0][0], N_ZONES * N_FIELDS, work);
+
+	for (int i = 0; i < N_SUMS; ++i)
+		SUMS[i] = buffer[i];
+#endif
+
+	if (!I_AM_NODE_ZERO_P)
+		return true;
+
+	FILE *file = fopen(GOB_ZONE_STATS_FILE, "w");
+	if (!file)
+		return false;
+
+	write_json(file, cells, sums, min, max, low, high, options, explosive_mix);
+
+	return fclose(file) == 0;
+}
@@ -0,0 +1,478 @@
+/**
+ * @file accuracy.c
+ *
+ * @brief Golden-reference accuracy harness of the VSI -> porosity ->
+ * resistance chain and the explosive gas volume.
+ *
+ *	accuracy -o reference.bin [-n cells] [-p params] [-s name=value]
+ *	accuracy -g reference.bin [-p params] [-s name=value] [-e field=budget]
+ *
+ * Each scenario (mine C, E and trona, partitioned and single part mesh) runs
+ * the steps of udf_main on a synthetic panel (panels.h): vsi_*_stepped,
+ * calc_gob_properties and calc_explosive_mix. -o records the fields with the
+ * scalar fits as the reference; -g runs them again in the mode under test
+ * (GOB_FITS_BATCH, and RP settings such as longwallgobs/vsi_raster_spacing or
+ * longwallgobs/omp_threads from -p files and -s) and compares.
+ *
+ * Errors are relative to the largest magnitude of the field in the scenario,
+ * so one budget covers VSI and resistances alike. Porosity errors carry over
+ * to the explosive volume one to one (udm-3 is 1 - porosity in explosive
+ * cells); the report gives the volume error next to its bound, the explosive
+ * volume times the worst porosity error. -g also checks that a property
+ * sweep variant keeping every computed setting reproduces udm-1, 0 and 5
+ * exactly. The exit status is nonzero if any field (or the explosive volume,
+ * "egz") is over its budget, or if the sweep differs.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // for getopt
+
+#include "udf.h"
+
+#include "fits_batch.h" // for fits_batch_isa
+#include "flammability.h" // for flam_load
+#include "omp_loop.h" // for gob_omp_threads
+#include "panels.h" // for the synthetic panels
+#include "params.h" // for gob_params_load
+#include "sweep.h" // for gob_sweep_run
+#include "udf_explosive_mix.h" // for calc_explosive_mix
+#include "udf_properties.h" // for calc_gob_properties
+
+#define REFERENCE_MAGIC "GOBREFER" // then int64 cells asked for, int32 scenarios, int32 fields
+
+#define N_SCENARIOS (2 * PANEL_N_MINES)
+
+/* default budget of every field and of the explosive volume: a few ulp of the batched fits, amplified */
+#define DEFAULT_BUDGET 1e-12
+
+#define MAX_SETTINGS 32
+
+/* compared fields, in the reference file's order */
+enum field { FIELD_VSI, FIELD_CLAMPED_VSI, FIELD_POROSITY, FIELD_VISCOUS, FIELD_INERTIAL, FIELD_MARKER, N_FIELDS };
+
+static const char *const FIELD_NAMES[N_FIELDS] = { "vsi", "clamped_vsi", "porosity", "viscous", "inertial", "marker" };
+
+/* UDM slot of each field */
+static const int FIELD_UDM[N_FIELDS] = { 6, 4, 1, 0, 5, 3 };
+
+/* one scenario's results */
+struct run {
+	long n;
+	double explosive_volume;
+	long sweep_mismatches; // cells where the sweep's computed-settings variant differs, -1 if it failed
+	double *fields[N_FIELDS];
+	double *x, *y, *volume;
+};
+
+/* -s settings, applied over every scenario's panel settings */
+static const char *settings[MAX_SETTINGS][2];
+static int n_settings = 0;
+
+static void run_free(struct run *run)
+{
+	for (int f = 0; f < N_FIELDS; ++f)
+		free(run->fields[f]);
+
+	free(run->x);
+	free(run->y);
+	free(run->volume);
+	memset(run, 0, sizeof(*run));
+}
+
+static bool run_alloc(struct run *run, const long n)
+{
+	bool ok = true;
+
+	run->n = n;
+
+	for (int f = 0; f < N_FIELDS; ++f)
+		ok &= (run->fields[f] = malloc(n * sizeof(double) + 1)) != NULL;
+
+	ok &= (run->x = malloc(n * sizeof(double) + 1)) != NULL;
+	ok &= (run->y = malloc(n * sizeof(double) + 1)) != NULL;
+	ok &= (run->volume = malloc(n * sizeof(double) + 1)) != NULL;
+
+	if (!ok)
+		run_free(run);
+
+	return ok;
+}
+
+/* cells where a sweep variant that keeps every computed setting differs
+   from udm-1, 0 or 5 (it must reproduce them exactly), -1 if the sweep failed */
+static long sweep_mismatches(const struct gob_params *params)
+{
+	struct gob_sweep sweep = { .n = 1 };
+
+	sweep.max_vsi[0] = sweep.max_porosity[0] = sweep.initial_porosity[0] = sweep.resist_scaler[0] = NAN;
+
+	if (!gob_sweep_run(&shim_domain, &sweep, params, false))
+		return -1;
+
+	FILE *file = fopen("longwallgobs-sweep.fields", "rb");
+	char magic[8];
+	uint32_t header[3];
+	long mismatches = 0;
+	bool ok = file && fread(magic, 8, 1, file) == 1 && fread(header, sizeof(header), 1, file) == 1;
+
+	Thread *t;
+	cell_t c;
+
+	thread_loop_c(t, &shim_domain)
+	{
+		int32_t ids[2];
+		ok = ok && fread(ids, sizeof(ids), 1, file) == 1;
+
+		begin_c_loop(c, t)
+		{
+			real values[3]; // porosity, viscous, inertial of the one variant
+
+			ok = ok && fread(values, sizeof(values), 1, file) == 1;
+
+			if (ok && (values[0] != C_UDMI(c, t, 1) || values[1] != C_UDMI(c, t, 0) ||
+				   values[2] != C_UDMI(c, t, 5)))
+				++mismatches;
+		}
+		end_c_loop(c, t)
+	}
+
+	if (file)
+		fclose(file);
+
+	remove("longwallgobs-sweep.fields");
+	remove("longwallgobs-sweep.csv");
+
+	return ok ? mismatches : -1;
+}
+
+/* the steps of udf_main on one synthetic panel, fields gathered in mesh order */
+static bool run_scenario(const enum panel_mine mine, const bool single, const long n_cells, struct run *run)
+{
+	struct gob_params params;
+	struct gob_options options;
+
+	panel_settings(mine, single);
+	RP_Set_Boolean("longwallgobs/egz_radio_button", true);
+
+	for (int i = 0; i < n_settings; ++i)
+		RP_Set_String(settings[i][0], settings[i][1]);
+
+	gob_params_load(&params, &options, &shim_domain);
+	gob_omp_threads = options.omp_threads;
+	flam_load(&gob_flammability);
+
+	const long N = panel_mesh(&params, &options, PANEL_MIX_ALL, n_cells);
+
+	if (!N || !run_alloc(run, N))
+		return false;
+
+	panel_vsi(mine, &params);
+	calc_gob_properties(&params, true);
+	run->sweep_mismatches = sweep_mismatches(&params);
+	run->explosive_volume = options.explosive_mix ? calc_explosive_mix() : 0;
+
+	Thread *t;
+	cell_t c;
+	long i = 0;
+
+	thread_loop_c(t, &shim_domain)
+	{
+		begin_c_loop(c, t)
+		{
+			for (int f = 0; f < N_FIELDS; ++f)
+				run->fields[f][i] = C_UDMI(c, t, FIELD_UDM[f]);
+
+			run->x[i] = t->centroid[c][0];
+			run->y[i] = t->centroid[c][1];
+			run->volume[i] = C_VOLUME(c, t);
+			++i;
+		}
+		end_c_loop(c, t)
+	}
+
+	shim_domain_clear();
+	return true;
+}
+
+static bool record(const char *path, const long n_cells)
+{
+	FILE *file = fopen(path, "wb");
+
+	if (!file) {
+		Message("Reference: could not open %s\n", path);
+		return false;
+	}
+
+	const int64_t CELLS = n_cells;
+	const int32_t COUNTS[2] = { N_SCENARIOS, N_FIELDS };
+
+	bool ok = fwrite(REFERENCE_MAGIC, 8, 1, file) == 1;
+	ok = ok && fwrite(&CELLS, sizeof(CELLS), 1, file) == 1;
+	ok = ok && fwrite(COUNTS, sizeof(COUNTS), 1, file) == 1;
+
+	bool computed = true;
+
+	for (int s = 0; ok && s < N_SCENARIOS; ++s) {
+		struct run run = { 0 };
+
+		if (!(computed = run_scenario(s / 2, s % 2, n_cells, &run)))
+			break;
+
+		const int64_t N = run.n;
+
+		ok = fwrite(&N, sizeof(N), 1, file) == 1;
+		ok = ok && fwrite(&run.explosive_volume, sizeof(double), 1, file) == 1;
+
+		for (int f = 0; ok && f < N_FIELDS; ++f)
+			ok = fwrite(run.fields[f], sizeof(double), run.n, file) == (size_t)run.n;
+
+		Message("%-6s %-12s %8ld cells, explosive volume %.10g m^3\n", PANEL_MINE_NAMES[s / 2],
+			s % 2 ? "single" : "partitioned", run.n, run.explosive_volume);
+		run_free(&run);
+	}
+
+	ok = (fclose(file) == 0) && ok;
+
+	if (!computed)
+		Message("Reference: out of memory\n");
+	else if (!ok)
+		Message("Reference: could not write %s\n", path);
+
+	return computed && ok;
+}
+
+/* error of one field against the reference */
+struct error {
+	double max_abs, max_rel, rms_rel;
+	long worst; // cell of max_abs
+};
+
+static struct error compare(const double *reference, const double *test, const long n)
+{
+	struct error error = { 0, 0, 0, 0 };
+	double scale = 0, sum = 0;
+
+	for (long i = 0; i < n; ++i)
+		scale = fmax(scale, fabs(reference[i]));
+
+	scale = scale > 0 ? scale : 1;
+
+	for (long i = 0; i < n; ++i) {
+		const double ABS = fabs(test[i] - reference[i]);
+
+		// NaN counts as infinitely wrong
+		if (!(ABS <= error.max_abs)) {
+			error.max_abs = isnan(ABS) ? INFINITY : ABS;
+			error.worst = i;
+		}
+
+		sum += (ABS / scale) * (ABS / scale);
+	}
+
+	error.max_rel = error.max_abs / scale;
+	error.rms_rel = n ? sqrt(sum / n) : 0;
+	return error;
+}
+
+static const char *verdict(const double error, const double budget)
+{
+	return error <= budget ? "ok" : "OVER";
+}
+
+static bool check(const char *path, const double budgets[N_FIELDS + 1])
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file) {
+		Message("Reference: could not open %s\n", path);
+		return false;
+	}
+
+	char magic[8];
+	int64_t cells;
+	int32_t counts[2];
+
+	if (fread(magic, 8, 1, file) != 1 || memcmp(magic, REFERENCE_MAGIC, 8) != 0 ||
+	    fread(&cells, sizeof(cells), 1, file) != 1 || fread(counts, sizeof(counts), 1, file) != 1 ||
+	    counts[0] != N_SCENARIOS || counts[1] != N_FIELDS) {
+		Message("Reference: %s is not a reference of this harness\n", path);
+		fclose(file);
+		return false;
+	}
+
+	double worst[N_FIELDS + 1] = { 0 };
+	bool sweep_ok = true;
+	bool pass = true;
+
+	for (int s = 0; s < N_SCENARIOS; ++s) {
+		struct run reference = { 0 }, test = { 0 };
+		int64_t n;
+		bool ok = fread(&n, sizeof(n), 1, file) == 1 && run_alloc(&reference, (long)n) &&
+			  fread(&reference.explosive_volume, sizeof(double), 1, file) == 1;
+
+		for (int f = 0; ok && f < N_FIELDS; ++f)
+			ok = fread(reference.fields[f], sizeof(double), reference.n, file) == (size_t)reference.n;
+
+		if (!ok || !run_scenario(s / 2, s % 2, (long)cells, &test) || test.n != reference.n) {
+			Message("Reference: %s is truncated, or its meshes differ from this build's\n", path);
+			run_free(&reference);
+			run_free(&test);
+			fclose(file);
+			return false;
+		}
+
+		printf("\nmine %s, %s (%ld cells)\n", PANEL_MINE_NAMES[s / 2], s % 2 ? "single part mesh" : "partitioned",
+		       test.n);
+		printf("  %-12s %12s %12s %12s %22s %10s\n", "field", "max abs", "max rel", "rms rel", "worst at (x, y)",
+		       "budget");
+
+		double porosity_error = 0;
+
+		for (int f = 0; f < N_FIELDS; ++f) {
+			const struct error ERROR = compare(reference.fields[f], test.fields[f], test.n);
+
+			printf("  %-12s %12.3e %12.3e %12.3e   (%8.2f, %8.2f) %10.1e %s\n", FIELD_NAMES[f], ERROR.max_abs,
+			       ERROR.max_rel, ERROR.rms_rel, test.x[ERROR.worst], test.y[ERROR.worst], budgets[f],
+			       verdict(ERROR.max_rel, budgets[f]));
+
+			worst[f] = fmax(worst[f], ERROR.max_rel);
+			pass &= ERROR.max_rel <= budgets[f];
+
+			if (f == FIELD_POROSITY)
+				porosity_error = ERROR.max_abs;
+		}
+
+		// the explosive marker is 1 - porosity, so the volume moves at most by this much
+		const double VOLUME_ERROR = fabs(test.explosive_volume - reference.explosive_volume);
+		const double VOLUME_REL = reference.explosive_volume > 0 ? VOLUME_ERROR / reference.explosive_volume : VOLUME_ERROR;
+		double explosive_cells_volume = 0;
+
+		for (long i = 0; i < test.n; ++i)
+			if (reference.fields[FIELD_MARKER][i] > 0 || test.fields[FIELD_MARKER][i] > 0)
+				explosive_cells_volume += test.volume[i];
+
+		printf("  %-12s %12.3e %12.3e %12s   bound %-14.3e %10.1e %s\n", "egz", VOLUME_ERROR, VOLUME_REL, "",
+		       explosive_cells_volume * porosity_error, budgets[N_FIELDS], verdict(VOLUME_REL, budgets[N_FIELDS]));
+		printf("  explosive volume %.10g m^3 (reference %.10g m^3)\n", test.explosive_volume,
+		       reference.explosive_volume);
+
+		worst[N_FIELDS] = fmax(worst[N_FIELDS], VOLUME_REL);
+		pass &= VOLUME_REL <= budgets[N_FIELDS];
+
+		// exact in every mode, so no budget
+		printf("  %-12s %ld cells differ from the stored porosity and resistances %s\n", "sweep",
+		       test.sweep_mismatches, test.sweep_mismatches == 0 ? "ok" : "OVER");
+		sweep_ok &= test.sweep_mismatches == 0;
+
+		run_free(&reference);
+		run_free(&test);
+	}
+
+	fclose(file);
+
+	printf("\nworst relative error over all scenarios\n");
+
+	for (int f = 0; f <= N_FIELDS; ++f)
+		printf("  %-12s %12.3e %10.1e %s\n", f < N_FIELDS ? FIELD_NAMES[f] : "egz", worst[f], budgets[f],
+		       verdict(worst[f], budgets[f]));
+
+	printf("  %-12s %s\n", "sweep", sweep_ok ? "reproduces the stored fields" : "DIFFERS from the stored fields");
+
+	pass &= sweep_ok;
+	printf("\n%s\n", pass ? "PASS" : "FAIL");
+	return pass;
+}
+
+/* "field=budget", where the field may also be "egz" or "all" */
+static bool parse_budget(const char *text, double budgets[N_FIELDS + 1])
+{
+	const char *equals = strchr(text, '=');
+	char name[32], *end;
+
+	if (!equals || (size_t)(equals - text) >= sizeof(name))
+		return false;
+
+	memcpy(name, text, equals - text);
+	name[equals - text] = '\0';
+
+	const double BUDGET = strtod(equals + 1, &end);
+	bool found = false;
+
+	if (end == equals + 1 || *end != '\0' || !(BUDGET >= 0))
+		return false;
+
+	for (int f = 0; f <= N_FIELDS; ++f)
+		if (strcmp(name, "all") == 0 || strcmp(name, f < N_FIELDS ? FIELD_NAMES[f] : "egz") == 0) {
+			budgets[f] = BUDGET;
+			found = true;
+		}
+
+	return found;
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: accuracy -o reference.bin [-n cells] [-p params] [-s name=value]\n"
+			"       accuracy -g reference.bin [-p params] [-s name=value] [-e field=budget]\n"
+			"fields: vsi clamped_vsi porosity viscous inertial marker egz all\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *output = NULL, *reference = NULL;
+	double budgets[N_FIELDS + 1];
+	long n_cells = 1 << 18;
+	int option;
+
+	for (int f = 0; f <= N_FIELDS; ++f)
+		budgets[f] = DEFAULT_BUDGET;
+
+	while ((option = getopt(argc, argv, "o:g:n:p:s:e:")) != -1) {
+		if (option == 'o') {
+			output = optarg;
+		} else if (option == 'g') {
+			reference = optarg;
+		} else if (option == 'n') {
+			n_cells = atol(optarg);
+		} else if (option == 'p') {
+			if (!rp_load(optarg))
+				return EXIT_FAILURE;
+		} else if (option == 's' && strchr(optarg, '=') && n_settings < MAX_SETTINGS) {
+			char *equals = strchr(optarg, '=');
+
+			*equals = '\0';
+			settings[n_settings][0] = optarg;
+			settings[n_settings][1] = equals + 1;
+			++n_settings;
+		} else if (option == 'e' && parse_budget(optarg, budgets)) {
+			continue;
+		} else {
+			usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (!output == !reference || optind != argc || n_cells < 1 || n_cells > 1L << 28) {
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	if (output) {
+		// the reference is the scalar code
+		setenv("GOB_FITS_BATCH", "scalar", 1);
+		Message("Recording the reference (%s fits) to %s\n", fits_batch_isa(), output);
+		return record(output, n_cells) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	printf("Checking against %s: %s fits", reference, fits_batch_isa());
+
+	for (int i = 0; i < n_settings; ++i)
+		printf(", %s=%s", settings[i][0], settings[i][1]);
+
+	printf("\n");
+
+	return check(reference, budgets) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
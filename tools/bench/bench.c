@@ -0,0 +1,403 @@
+/**
+ * @file bench.c
+ *
+ * @brief Microbenchmarks of the UDF hot paths, built against the udf.h
+ * stand-in (tools/shim):
+ *
+ *	fits         every fits.c fit, one point at a time and batched (per
+ *	             precision tier)
+ *	vsi          every vsi_*_stepped macro, per mesh mode and region mix,
+ *	             in double and float32
+ *	properties   calc_gob_properties (double and float32) and the property
+ *	             profiles
+ *	adaption     gob_adaption_refresh with every 8th cell new
+ *	egz          calc_explosive_mix, built-in diagram and data file
+ *
+ * The synthetic meshes (panels.h) cover the panel of each mine model plus a
+ * margin, as one zone per role (partitioned) or one zone (single part mesh).
+ * Region mixes keep only the cells of one kind of panel region (pure fit,
+ * blend across a zone edge, outside the panel), repeated up to the cell
+ * count.
+ * Each benchmark reports the best of several runs, in ns and TSC cycles per
+ * cell and in cells per second.
+ *
+ *	bench [-n cells] [-r repeats] [-t omp_threads] [-f flammability.dat] [-k filter]
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h> // for getopt
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // for __rdtsc
+#define HAVE_TSC 1
+#else
+#define HAVE_TSC 0
+#endif
+
+#include "udf.h"
+
+#include "adaption.h" // for gob_adaption_refresh
+#include "fits_batch.h" // for fits_batch_isa, fits_batch_set_precision
+#include "flammability.h" // for flam_load
+#include "omp_loop.h" // for gob_omp_threads
+#include "panels.h" // for the synthetic panels
+#include "params.h" // for gob_params_load
+#include "udf_explosive_mix.h" // for calc_explosive_mix
+#include "udf_properties.h" // for calc_gob_properties
+#include "vsi_stepped.h" // for vsi_fit, vsi_fit_n
+
+/* property profiles of udf_main.c */
+DEFINE_PROFILE(set_poro_VSI, t, nv);
+DEFINE_PROFILE(set_perm_1_VSI, t, nv);
+DEFINE_PROFILE(set_inertia_1_VSI, t, nv);
+
+/* points per fit benchmark */
+#define FIT_POINTS 4096
+
+/* row name suffix of each enum fits_precision */
+static const char *const PRECISION_NAMES[] = { "", " 1e-7", " 1e-4", " float32" };
+
+/* settings */
+static long n_cells = 1 << 20;
+static int repeats = 5;
+static const char *filter = "";
+
+/* BENCHMARK HARNESS **********************************************************/
+
+struct timing {
+	double ns; // best wall time of one run
+	double cycles; // TSC cycles of that run (0 without a TSC)
+};
+
+typedef void (*run_fn)(void *context);
+
+static double now_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+static uint64_t now_cycles(void)
+{
+#if HAVE_TSC
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+/* best of the repeats, after one warm-up run */
+static struct timing measure(run_fn run, void *context)
+{
+	struct timing best = { INFINITY, 0 };
+
+	run(context);
+
+	for (int r = 0; r < repeats; ++r) {
+		const double START = now_ns();
+		const uint64_t START_CYCLES = now_cycles();
+
+		run(context);
+
+		const double NS = now_ns() - START;
+		const uint64_t CYCLES = now_cycles() - START_CYCLES;
+
+		if (NS < best.ns) {
+			best.ns = NS;
+			best.cycles = (double)CYCLES;
+		}
+	}
+
+	return best;
+}
+
+static bool selected(const char *name)
+{
+	return strstr(name, filter) != NULL;
+}
+
+static void report(const char *name, const long items, const struct timing timing)
+{
+	if (HAVE_TSC)
+		printf("%-64s %9ld %10.2f %10.1f %10.2f\n", name, items, timing.ns / items, timing.cycles / items,
+		       items / timing.ns * 1e3);
+	else
+		printf("%-64s %9ld %10.2f %10s %10.2f\n", name, items, timing.ns / items, "-", items / timing.ns * 1e3);
+}
+
+/* FITS ***********************************************************************/
+
+struct fit_run {
+	int fit;
+	double *x, *y, *out;
+	long passes; // over the FIT_POINTS points
+	double sink; // keeps the scalar results alive
+};
+
+static void run_fit_scalar(void *context)
+{
+	struct fit_run *run = context;
+	double sum = 0;
+
+	for (long p = 0; p < run->passes; ++p)
+		for (int i = 0; i < FIT_POINTS; ++i)
+			sum += vsi_fit(run->fit, run->x[i], run->y[i]);
+
+	run->sink += sum;
+}
+
+static void run_fit_batch(void *context)
+{
+	struct fit_run *run = context;
+
+	for (long p = 0; p < run->passes; ++p)
+		vsi_fit_n(run->fit, run->x, run->y, run->out, FIT_POINTS);
+}
+
+static void bench_fits(void)
+{
+	double x[FIT_POINTS], y[FIT_POINTS], out[FIT_POINTS];
+
+	// normalized coordinates cover [0, 1], as within a zone
+	srand(1);
+	for (int i = 0; i < FIT_POINTS; ++i) {
+		x[i] = rand() / (double)RAND_MAX;
+		y[i] = rand() / (double)RAND_MAX;
+	}
+
+	struct fit_run run = { .x = x, .y = y, .out = out, .passes = (n_cells + FIT_POINTS - 1) / FIT_POINTS };
+	const long POINTS = run.passes * FIT_POINTS;
+
+	for (int fit = 0; fit < VSI_FIT_COUNT; ++fit) {
+		char name[128];
+
+		run.fit = fit;
+
+		snprintf(name, sizeof(name), "fit %s", VSI_FIT_NAMES[fit]);
+		if (selected(name))
+			report(name, POINTS, measure(run_fit_scalar, &run));
+
+		for (int tier = FITS_PRECISION_EXACT; tier <= FITS_PRECISION_FLOAT32; ++tier) {
+			snprintf(name, sizeof(name), "fit %s_n%s", VSI_FIT_NAMES[fit], PRECISION_NAMES[tier]);
+			fits_batch_set_precision(tier);
+
+			if (selected(name))
+				report(name, POINTS, measure(run_fit_batch, &run));
+		}
+
+		fits_batch_set_precision(FITS_PRECISION_EXACT);
+	}
+}
+
+/* CELL MACROS ****************************************************************/
+
+struct mesh_run {
+	struct gob_params params; // as loaded, or switched to float32 (set_single_precision)
+	enum panel_mine mine;
+	double sink;
+};
+
+static void run_vsi(void *context)
+{
+	struct mesh_run *run = context;
+
+	panel_vsi(run->mine, &run->params);
+}
+
+static void run_properties(void *context)
+{
+	struct mesh_run *run = context;
+
+	calc_gob_properties(&run->params, true);
+}
+
+static void run_profiles(void *context)
+{
+	(void)context;
+
+	Thread *t;
+
+	thread_loop_c(t, &shim_domain)
+	{
+		set_poro_VSI(t, 0);
+		set_perm_1_VSI(t, 0);
+		set_inertia_1_VSI(t, 0);
+	}
+}
+
+static void run_explosive_mix(void *context)
+{
+	struct mesh_run *run = context;
+
+	run->sink += calc_explosive_mix();
+}
+
+/* every 8th cell as an adaption leaves it, then the refresh that finds and computes them */
+static void run_adaption(void *context)
+{
+	struct mesh_run *run = context;
+	Thread *t;
+	cell_t c;
+
+	thread_loop_c(t, &shim_domain)
+	{
+		begin_c_loop(c, t)
+		{
+			if (c % 8 == 0)
+				C_UDMI(c, t, 8) = -1;
+		}
+		end_c_loop(c, t);
+	}
+
+	run->sink += gob_adaption_refresh(&shim_domain, &run->params);
+}
+
+/* float32 fits and resistances on or off, as longwallgobs/single_precision would */
+static void set_single_precision(struct mesh_run *run, const struct gob_params *loaded, const bool single)
+{
+	run->params = *loaded;
+
+	if (single) {
+		run->params.single_precision = true;
+		run->params.fit_precision = FITS_PRECISION_FLOAT32;
+	}
+}
+
+static void set_flammability_file(const char *path)
+{
+	RP_Set_String("longwallgobs/flammability_file", path);
+	flam_load(&gob_flammability);
+}
+
+static void bench_mesh(const char *flammability_file)
+{
+	for (int mine = 0; mine < PANEL_N_MINES; ++mine)
+		for (int single = 0; single < 2; ++single) {
+			const char *MINE = PANEL_MINE_NAMES[mine];
+			const char *MODE = single ? "single" : "partitioned";
+			struct mesh_run run = { .mine = mine };
+			struct gob_options options;
+			char name[160];
+			long cells;
+
+			struct gob_params loaded;
+
+			panel_settings(mine, single);
+			gob_params_load(&loaded, &options, &shim_domain);
+			run.params = loaded;
+
+			for (int mix = 0; mix < PANEL_N_MIXES; ++mix)
+				for (int f32 = 0; f32 < 2; ++f32) {
+					snprintf(name, sizeof(name), "%s %s %s%s", PANEL_STEPPED_NAMES[mine], MODE,
+						 PANEL_MIX_NAMES[mix], f32 ? " float32" : "");
+					set_single_precision(&run, &loaded, f32);
+
+					if (selected(name) && (cells = panel_mesh(&run.params, &options, mix, n_cells)))
+						report(name, cells, measure(run_vsi, &run));
+				}
+
+			set_single_precision(&run, &loaded, false);
+
+			// the rest do not depend on the region, only on the values
+			char properties[128], profiles[128], egz[128], adaption[128];
+
+			snprintf(properties, sizeof(properties), "calc_gob_properties mine %s %s", MINE, MODE);
+			snprintf(profiles, sizeof(profiles), "profiles x3 mine %s %s", MINE, MODE);
+			snprintf(egz, sizeof(egz), "calc_explosive_mix mine %s %s", MINE, MODE);
+			snprintf(adaption, sizeof(adaption), "adaption 1/8 new mine %s %s", MINE, MODE);
+
+			if (!(selected(properties) || selected(profiles) || selected(egz) || selected(adaption)) ||
+			    !(cells = panel_mesh(&run.params, &options, PANEL_MIX_ALL, n_cells)))
+				continue;
+
+			run_vsi(&run);
+
+			if (selected(properties)) {
+				report(properties, cells, measure(run_properties, &run));
+
+				snprintf(name, sizeof(name), "%s float32", properties);
+				set_single_precision(&run, &loaded, true);
+				report(name, cells, measure(run_properties, &run));
+				set_single_precision(&run, &loaded, false);
+			}
+
+			run_properties(&run);
+
+			// per cell of the whole mesh, to compare with the VSI + properties rows
+			if (selected(adaption))
+				report(adaption, cells, measure(run_adaption, &run));
+
+			if (selected(profiles))
+				report(profiles, 3 * cells, measure(run_profiles, &run));
+
+			if (selected(egz)) {
+				set_flammability_file("");
+				snprintf(name, sizeof(name), "%s built-in", egz);
+				report(name, cells, measure(run_explosive_mix, &run));
+
+				if (flammability_file) {
+					set_flammability_file(flammability_file);
+					snprintf(name, sizeof(name), "%s file", egz);
+					report(name, cells, measure(run_explosive_mix, &run));
+					set_flammability_file("");
+				}
+			}
+		}
+
+	shim_domain_clear();
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: bench [-n cells] [-r repeats] [-t omp_threads] [-f flammability.dat] [-k filter]\n");
+}
+
+int main(int argc, char **argv)
+{
+	const char *flammability_file = NULL;
+	int option;
+
+	while ((option = getopt(argc, argv, "n:r:t:f:k:")) != -1) {
+		if (option == 'n') {
+			n_cells = atol(optarg);
+		} else if (option == 'r') {
+			repeats = atoi(optarg);
+		} else if (option == 't') {
+			gob_omp_threads = atoi(optarg);
+		} else if (option == 'f') {
+			flammability_file = optarg;
+		} else if (option == 'k') {
+			filter = optarg;
+		} else {
+			usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (n_cells < 1 || n_cells > 1L << 30 || repeats < 1) {
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	printf("cells %ld, best of %d, batched fits on %s, %d OpenMP threads%s\n\n", n_cells, repeats,
+	       fits_batch_isa(), gob_omp_threads,
+#ifdef _OPENMP
+	       ""
+#else
+	       " (built without OpenMP)"
+#endif
+	);
+	printf("%-64s %9s %10s %10s %10s\n", "benchmark", "items", "ns/item", HAVE_TSC ? "cyc/item" : "-",
+	       "Mitems/s");
+
+	bench_fits();
+	bench_mesh(flammability_file);
+
+	return EXIT_SUCCESS;
+}
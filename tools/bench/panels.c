@@ -0,0 +1,211 @@
+/**
+ * @file panels.c
+ *
+ * @brief Synthetic panels of every mine model, see panels.h.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "panels.h"
+
+#include "udf_vsi.h" // for vsi_panel_coords, vsi_*_stepped
+#include "vsi_layout.h" // for vsi_layout_of
+
+const char *const PANEL_MINE_NAMES[PANEL_N_MINES] = { "C", "E", "trona" };
+
+const char *const PANEL_STEPPED_NAMES[PANEL_N_MINES] = { "vsi_mine_C_stepped", "vsi_mine_E_stepped",
+							 "vsi_trona_stepped" };
+
+const char *const PANEL_MIX_NAMES[PANEL_N_MIXES] = { "all", "pure", "blend", "outside" };
+
+/* the grid: the largest panel plus a 10 m margin */
+#define GRID_MIN_X -170.0
+#define GRID_MAX_X 170.0
+#define GRID_MIN_Y -15.0
+#define GRID_MAX_Y 1215.0
+
+/* zone bounds of the partitioned panels (see udf_vsi.h) */
+static void set_zone(const char *role, const double min_x, const double max_x, const double min_y,
+		     const double max_y)
+{
+	char name[96];
+
+	snprintf(name, sizeof(name), "longwallgobs/%s_min_x", role);
+	RP_Set_Real(name, min_x);
+	snprintf(name, sizeof(name), "longwallgobs/%s_max_x", role);
+	RP_Set_Real(name, max_x);
+	snprintf(name, sizeof(name), "longwallgobs/%s_min_y", role);
+	RP_Set_Real(name, min_y);
+	snprintf(name, sizeof(name), "longwallgobs/%s_max_y", role);
+	RP_Set_Real(name, max_y);
+}
+
+void panel_settings(const enum panel_mine mine, const bool single_part_mesh)
+{
+	RP_Set_Boolean("mine_c", mine == PANEL_MINE_C);
+	RP_Set_Boolean("mine_e", mine == PANEL_MINE_E);
+	RP_Set_Boolean("mine_t", mine == PANEL_MINE_T);
+
+	for (int role = 0; role < GOB_N_ROLES; ++role) {
+		char name[96];
+
+		snprintf(name, sizeof(name), "longwallgobs/%s_id", GOB_ROLE_NAMES[role]);
+		RP_Set_Integer(name, -1);
+		set_zone(GOB_ROLE_NAMES[role], 0, 0, 0, 0);
+	}
+
+	if (single_part_mesh) {
+		RP_Set_Integer("longwallgobs/single_part_mesh_id", 1);
+
+		if (mine == PANEL_MINE_T)
+			set_zone("single_part_mesh", -152.5, 152.5, 0, 1000);
+		else
+			set_zone("single_part_mesh", -160, 160, 0, 1200);
+	} else if (mine == PANEL_MINE_T) {
+		RP_Set_Integer("longwallgobs/startup_room_corner_id", 1);
+		RP_Set_Integer("longwallgobs/mid_panel_gateroad_id", 2);
+		RP_Set_Integer("longwallgobs/working_face_corner_id", 3);
+		set_zone("startup_room_corner", 0, 152.5, 810, 1000);
+		set_zone("mid_panel_gateroad", 0, 152.5, 400, 810);
+		set_zone("working_face_corner", 0, 152.5, 0, 400);
+	} else {
+		for (int role = 0; role < GOB_SINGLE_PART_MESH; ++role) {
+			char name[96];
+
+			snprintf(name, sizeof(name), "longwallgobs/%s_id", GOB_ROLE_NAMES[role]);
+			RP_Set_Integer(name, 1 + role);
+		}
+
+		set_zone("startup_room_center", -92.5, 92.5, 1010, 1200);
+		set_zone("startup_room_corner", 92.5, 160, 1010, 1200);
+		set_zone("mid_panel_center", -92.5, 92.5, 190, 1010);
+		set_zone("mid_panel_gateroad", 92.5, 160, 190, 1010);
+		set_zone("working_face_center", -92.5, 92.5, 0, 190);
+		set_zone("working_face_corner", 92.5, 160, 0, 190);
+	}
+}
+
+static bool in_mix(const int region, const enum panel_mix mix)
+{
+	switch (mix) {
+	case PANEL_MIX_PURE:
+		return region == VSI_REGION_PURE;
+	case PANEL_MIX_BLEND:
+		return region == VSI_REGION_BLEND_X || region == VSI_REGION_BLEND_Y;
+	case PANEL_MIX_OUTSIDE:
+		return region == VSI_REGION_OUTSIDE;
+	default:
+		return true;
+	}
+}
+
+/* role whose selected zone holds the point, GOB_N_ROLES for the strata */
+static int zone_of(const struct gob_params *params, const struct gob_options *options, const double x,
+		   const double y)
+{
+	const struct gob_zone_bounds *BOUNDS[GOB_N_ROLES] = {
+		[GOB_STARTUP_ROOM_CENTER] = &params->startup_room_center,
+		[GOB_STARTUP_ROOM_CORNER] = &params->startup_room_corner,
+		[GOB_MID_PANEL_CENTER] = &params->mid_panel_center,
+		[GOB_MID_PANEL_GATEROAD] = &params->mid_panel_gateroad,
+		[GOB_WORKING_FACE_CENTER] = &params->working_face_center,
+		[GOB_WORKING_FACE_CORNER] = &params->working_face_corner,
+		[GOB_SINGLE_PART_MESH] = &params->single_part_mesh_bounds,
+	};
+
+	for (int role = 0; role < GOB_N_ROLES; ++role)
+		if (options->zone_ids[role] >= 0 && x >= BOUNDS[role]->min_x && x < BOUNDS[role]->max_x &&
+		    y >= BOUNDS[role]->min_y && y < BOUNDS[role]->max_y)
+			return role;
+
+	return GOB_N_ROLES;
+}
+
+long panel_mesh(const struct gob_params *params, const struct gob_options *options, const enum panel_mix mix,
+		const long n_cells)
+{
+	struct vsi_layout layout;
+	vsi_layout_of(params)(&layout, params);
+
+	// about n_cells grid points with square cells
+	const double SPACING = sqrt((GRID_MAX_X - GRID_MIN_X) * (GRID_MAX_Y - GRID_MIN_Y) / n_cells);
+	const int NX = (int)ceil((GRID_MAX_X - GRID_MIN_X) / SPACING);
+	const int NY = (int)ceil((GRID_MAX_Y - GRID_MIN_Y) / SPACING);
+
+	struct point {
+		double x, y;
+		int zone;
+	} *kept = malloc((size_t)NX * NY * sizeof(*kept));
+	long n_kept = 0;
+
+	if (!kept)
+		return 0;
+
+	for (int j = 0; j < NY; ++j)
+		for (int i = 0; i < NX; ++i) {
+			const double X = GRID_MIN_X + (i + 0.5) * SPACING;
+			const double Y = GRID_MIN_Y + (j + 0.5) * SPACING;
+			struct vsi_sample sample;
+
+			layout.classify(fabs(X - params->panel_x_offset), fabs(Y - params->panel_y_offset), layout.BOX,
+					&sample);
+
+			if (in_mix(sample.region, mix))
+				kept[n_kept++] = (struct point){ X, Y, zone_of(params, options, X, Y) };
+		}
+
+	const long N = mix == PANEL_MIX_ALL ? n_kept : n_kept ? n_cells : 0;
+
+	// one thread per zone, in role order, then the strata
+	long counts[GOB_N_ROLES + 1] = { 0 };
+	Thread *threads[GOB_N_ROLES + 1] = { NULL };
+	cell_t next[GOB_N_ROLES + 1] = { 0 };
+	bool ok = N > 0;
+
+	for (long i = 0; i < N; ++i)
+		++counts[kept[i % n_kept].zone];
+
+	shim_domain_clear();
+
+	for (int zone = 0; ok && zone <= GOB_N_ROLES; ++zone)
+		if (counts[zone]) {
+			threads[zone] = shim_thread_new(zone < GOB_N_ROLES ? options->zone_ids[zone] : 0, (int)counts[zone]);
+			ok = threads[zone] != NULL;
+		}
+
+	for (long i = 0; ok && i < N; ++i) {
+		const struct point *POINT = &kept[i % n_kept];
+		Thread *t = threads[POINT->zone];
+		const cell_t c = next[POINT->zone]++;
+		const double S = (POINT->x - GRID_MIN_X) / (GRID_MAX_X - GRID_MIN_X);
+		const double R = (POINT->y - GRID_MIN_Y) / (GRID_MAX_Y - GRID_MIN_Y);
+
+		t->centroid[c][0] = POINT->x;
+		t->centroid[c][1] = POINT->y;
+		t->volume[c] = SPACING * SPACING;
+
+		// methane 0 .. 18 %, oxygen 24 .. 0 % by mass
+		C_YI(c, t, 0) = 0.18 * S * S;
+		C_YI(c, t, 1) = 0.24 * (1 - R) * (1 - 0.5 * S);
+	}
+
+	free(kept);
+
+	if (ok)
+		vsi_panel_coords(params); // once per mesh, as udf_main does
+	else
+		shim_domain_clear();
+
+	return ok ? N : 0;
+}
+
+void panel_vsi(const enum panel_mine mine, const struct gob_params *params)
+{
+	if (mine == PANEL_MINE_C)
+		vsi_mine_C_stepped(params);
+	else if (mine == PANEL_MINE_E)
+		vsi_mine_E_stepped(params);
+	else
+		vsi_trona_stepped(params);
+}
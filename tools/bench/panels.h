@@ -0,0 +1,68 @@
+/**
+ * @file panels.h
+ *
+ * @brief Synthetic panels of every mine model for the benchmarks and the
+ * accuracy harness: the GUI settings of each panel and a regular mesh over
+ * it, built in the udf.h stand-in's domain.
+ */
+
+#ifndef GOB_BENCH_PANELS_H
+#define GOB_BENCH_PANELS_H
+
+#include "udf.h"
+
+#include <stdbool.h>
+
+#include "params.h" // for struct gob_params, struct gob_options
+
+enum panel_mine { PANEL_MINE_C, PANEL_MINE_E, PANEL_MINE_T, PANEL_N_MINES };
+
+/* as in the reports: "C", "E", "trona" */
+extern const char *const PANEL_MINE_NAMES[PANEL_N_MINES];
+
+/* vsi_*_stepped macro of each mine */
+extern const char *const PANEL_STEPPED_NAMES[PANEL_N_MINES];
+
+/* cells kept in a mesh, by the kind of panel region they fall in */
+enum panel_mix { PANEL_MIX_ALL, PANEL_MIX_PURE, PANEL_MIX_BLEND, PANEL_MIX_OUTSIDE, PANEL_N_MIXES };
+
+extern const char *const PANEL_MIX_NAMES[PANEL_N_MIXES];
+
+/**
+ * @brief Sets the RP variables of a panel as the GUI would: the mine, one zone
+ * per role (partitioned) or a single part mesh, and the zone bounds. Every
+ * other setting keeps its value (or its default when unset).
+ *
+ * @param [in] mine mine model
+ * @param [in] single_part_mesh one zone for the whole gob
+ */
+void panel_settings(const enum panel_mine mine, const bool single_part_mesh);
+
+/**
+ * @brief Replaces the mesh with about n_cells cells over the panel and a
+ * 10 m margin: a regular grid of about n_cells square cells, every cell once
+ * for PANEL_MIX_ALL, otherwise the cells in the region mix repeated up to
+ * exactly n_cells. Each zone of the settings gets its cells as one thread
+ * with the zone's id; the rest go to a strata thread with id 0. Gas
+ * compositions sweep the flammability diagram across the grid. The cells are
+ * mapped to the panel frame (udm-8/9) before returning.
+ *
+ * @param [in] params snapshot of the panel_settings
+ * @param [in] options zone ids of the panel_settings
+ * @param [in] mix cells to keep
+ * @param [in] n_cells number of cells
+ * @return [long] number of cells, 0 if the mix is empty for this panel or
+ * out of memory
+ */
+long panel_mesh(const struct gob_params *params, const struct gob_options *options, const enum panel_mix mix,
+		const long n_cells);
+
+/**
+ * @brief Runs the mine's vsi_*_stepped macro over the mesh.
+ *
+ * @param [in] mine mine model
+ * @param [in] params snapshot of the panel_settings
+ */
+void panel_vsi(const enum panel_mine mine, const struct gob_params *params);
+
+#endif // GOB_BENCH_PANELS_H
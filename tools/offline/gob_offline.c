@@ -0,0 +1,364 @@
+/**
+ * @file gob_offline.c
+ *
+ * @brief Offline evaluator: VSI, porosity and both resistances of a dump of
+ * cell centroids and volumes, with the same parameters and code as the UDF,
+ * on any machine without Fluent.
+ *
+ *	gob_offline [-t threads] -p params [-p params ...] cells.{csv,bin} fields.{csv,bin}
+ *
+ * Cells are split into chunks that a work-stealing thread pool evaluates;
+ * each chunk runs the gather -> stepped VSI (or raster) -> clamp -> property
+ * steps of vsi_stepped_fields and calc_gob_properties, so the fields match
+ * what udf_main stores in the UDMs bit for bit.
+ */
+
+#include <math.h> // for INFINITY
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h> // for getopt, sysconf
+
+#include "udf.h"
+
+#include "fits_batch.h" // for fits_batch_set_precision
+#include "panel_frame.h" // for gob_panel_frame_map
+#include "params.h" // for gob_params_load
+#include "pool.h" // for pool_run
+#include "properties.h" // for gob_porosity, gob_resistances
+#include "utils.h" // for clamp
+#include "vsi_layout.h" // for vsi_layout_of
+#include "vsi_raster.h" // for tabulated VSI surfaces
+#include "vsi_stepped.h" // for struct vsi_batch
+
+/* cells per pool chunk: large enough for the batched fits, small enough to balance */
+#define CHUNK_CELLS 4096
+
+/* binary dumps start with one of these, followed by an int64_t cell count */
+#define CELLS_MAGIC "GOBCELLS" // then per cell: double x, y, z, volume
+#define FIELDS_MAGIC "GOBFIELD" // then per cell: double vsi, porosity, viscous, inertial
+
+struct cells {
+	long n;
+	double *x, *y, *z, *volume;
+	bool binary; // read from a binary dump (fields are written the same way)
+};
+
+struct fields {
+	double *vsi; // clamped, as in udm-4
+	double *porosity; // udm-1
+	double *viscous; // udm-0
+	double *inertial; // udm-5
+};
+
+struct job {
+	const struct gob_params *params;
+	const struct cells *cells;
+	struct fields *fields;
+	struct gob_panel_frame frame;
+	struct vsi_layout layout;
+	const struct vsi_raster *raster;
+	struct gob_property_model model;
+	struct vsi_batch batches[POOL_MAX_WORKERS]; // one per worker, reused across its chunks
+	_Atomic int failed; // chunks left unevaluated (out of memory)
+};
+
+static bool cells_alloc(struct cells *cells, const long n)
+{
+	cells->n = n;
+	cells->x = malloc(n * sizeof(double));
+	cells->y = malloc(n * sizeof(double));
+	cells->z = malloc(n * sizeof(double));
+	cells->volume = malloc(n * sizeof(double));
+
+	return n == 0 || (cells->x && cells->y && cells->z && cells->volume);
+}
+
+static bool read_binary(FILE *file, struct cells *cells)
+{
+	int64_t n;
+
+	if (fread(&n, sizeof(n), 1, file) != 1 || n < 0 || !cells_alloc(cells, (long)n))
+		return false;
+
+	for (long i = 0; i < cells->n; ++i) {
+		double record[4];
+
+		if (fread(record, sizeof(record), 1, file) != 1)
+			return false;
+
+		cells->x[i] = record[0];
+		cells->y[i] = record[1];
+		cells->z[i] = record[2];
+		cells->volume[i] = record[3];
+	}
+
+	return true;
+}
+
+/* x,y,z,volume per line; lines that do not start with a number (headers) are skipped */
+static bool read_csv(FILE *file, struct cells *cells)
+{
+	char line[512];
+	long capacity = 0;
+
+	cells->n = 0;
+
+	while (fgets(line, sizeof(line), file)) {
+		double x, y, z, volume;
+
+		if (sscanf(line, " %lf , %lf , %lf , %lf", &x, &y, &z, &volume) != 4)
+			continue;
+
+		if (cells->n == capacity) {
+			capacity = capacity ? 2 * capacity : 1 << 16;
+
+			double *grown[4] = { realloc(cells->x, capacity * sizeof(double)),
+					     realloc(cells->y, capacity * sizeof(double)),
+					     realloc(cells->z, capacity * sizeof(double)),
+					     realloc(cells->volume, capacity * sizeof(double)) };
+
+			cells->x = grown[0] ? grown[0] : cells->x;
+			cells->y = grown[1] ? grown[1] : cells->y;
+			cells->z = grown[2] ? grown[2] : cells->z;
+			cells->volume = grown[3] ? grown[3] : cells->volume;
+
+			if (!grown[0] || !grown[1] || !grown[2] || !grown[3])
+				return false;
+		}
+
+		cells->x[cells->n] = x;
+		cells->y[cells->n] = y;
+		cells->z[cells->n] = z;
+		cells->volume[cells->n] = volume;
+		++cells->n;
+	}
+
+	return true;
+}
+
+static bool read_cells(const char *path, struct cells *cells)
+{
+	FILE *file = fopen(path, "rb");
+
+	if (!file) {
+		Message("Cells: could not open %s\n", path);
+		return false;
+	}
+
+	char magic[8] = { 0 };
+	cells->binary = fread(magic, sizeof(magic), 1, file) == 1 && memcmp(magic, CELLS_MAGIC, 8) == 0;
+
+	if (!cells->binary)
+		rewind(file);
+
+	const bool OK = cells->binary ? read_binary(file, cells) : read_csv(file, cells);
+
+	fclose(file);
+
+	if (!OK)
+		Message("Cells: %s is truncated or too large\n", path);
+
+	return OK;
+}
+
+static bool write_fields(const char *path, const struct cells *cells, const struct fields *fields)
+{
+	FILE *file = fopen(path, "wb");
+
+	if (!file) {
+		Message("Fields: could not open %s\n", path);
+		return false;
+	}
+
+	bool ok;
+
+	if (cells->binary) {
+		const int64_t N = cells->n;
+
+		ok = fwrite(FIELDS_MAGIC, 8, 1, file) == 1;
+		ok = ok && fwrite(&N, sizeof(N), 1, file) == 1;
+
+		for (long i = 0; ok && i < cells->n; ++i) {
+			const double RECORD[4] = { fields->vsi[i], fields->porosity[i], fields->viscous[i],
+						   fields->inertial[i] };
+
+			ok = fwrite(RECORD, sizeof(RECORD), 1, file) == 1;
+		}
+	} else {
+		ok = fprintf(file, "x,y,z,volume,vsi,porosity,viscous_resistance,inertial_resistance\n") >= 0;
+
+		for (long i = 0; ok && i < cells->n; ++i)
+			ok = fprintf(file, "%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g\n", cells->x[i],
+				     cells->y[i], cells->z[i], cells->volume[i], fields->vsi[i], fields->porosity[i],
+				     fields->viscous[i], fields->inertial[i]) >= 0;
+	}
+
+	ok = (fclose(file) == 0) && ok;
+
+	if (!ok)
+		Message("Fields: could not write %s\n", path);
+
+	return ok;
+}
+
+/* one chunk: the steps of vsi_stepped_fields, then calc_gob_properties */
+static void evaluate_chunk(void *context, const int worker, const long chunk)
+{
+	struct job *job = context;
+	struct vsi_batch *batch = &job->batches[worker];
+	const long FIRST = chunk * CHUNK_CELLS;
+	const int N = (int)(job->cells->n - FIRST < CHUNK_CELLS ? job->cells->n - FIRST : CHUNK_CELLS);
+
+	if (!vsi_batch_reserve(batch, N)) {
+		atomic_fetch_add(&job->failed, 1);
+		return;
+	}
+
+	// vsi_panel_coords, rounded to real as udm-8/9 hold them
+	for (int i = 0; i < N; ++i) {
+		double x_loc, y_loc;
+
+		gob_panel_frame_map(&job->frame, job->cells->x[FIRST + i], job->cells->y[FIRST + i], &x_loc, &y_loc);
+		batch->x_loc[i] = (real)x_loc;
+		batch->y_loc[i] = (real)y_loc;
+	}
+
+	if (job->raster)
+		for (int i = 0; i < N; ++i)
+			batch->vsi[i] = vsi_raster_sample(job->raster, batch->x_loc[i], batch->y_loc[i]);
+	else
+		job->layout.stepped_n(batch, job->layout.BOX, N);
+
+	for (int i = 0; i < N; ++i) {
+		const long CELL = FIRST + i;
+		const real VSI = clamp(batch->vsi[i], 0, job->params->max_vsi);
+		const real POROSITY = gob_porosity(&job->model, VSI);
+		real viscous, inertial;
+
+		gob_resistances(&job->model, POROSITY, &viscous, &inertial);
+
+		job->fields->vsi[CELL] = VSI;
+		job->fields->porosity[CELL] = POROSITY;
+		job->fields->viscous[CELL] = viscous;
+		job->fields->inertial[CELL] = inertial;
+	}
+}
+
+static double seconds(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static void usage(void)
+{
+	fprintf(stderr, "usage: gob_offline [-t threads] -p params [-p params ...] cells.{csv,bin} fields.{csv,bin}\n");
+}
+
+int main(int argc, char **argv)
+{
+	int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	int n_params = 0;
+	int option;
+
+	while ((option = getopt(argc, argv, "t:p:")) != -1) {
+		if (option == 't') {
+			threads = atoi(optarg);
+		} else if (option == 'p') {
+			if (!rp_load(optarg))
+				return EXIT_FAILURE;
+
+			++n_params;
+		} else {
+			usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (n_params == 0 || argc - optind != 2) {
+		usage();
+		return EXIT_FAILURE;
+	}
+
+	// the same snapshot udf_main works from
+	Domain domain = { .c = NULL };
+	struct gob_params params;
+	struct gob_options options;
+	gob_params_load(&params, &options, &domain);
+
+	const vsi_layout_fn LAYOUT = vsi_layout_of(&params);
+
+	if (!LAYOUT) {
+		Message("No mine selected (mine_c, mine_e or mine_t)\n");
+		return EXIT_FAILURE;
+	}
+
+	struct cells cells = { 0 };
+
+	if (!read_cells(argv[optind], &cells))
+		return EXIT_FAILURE;
+
+	struct fields fields = { malloc(cells.n * sizeof(double) + 1), malloc(cells.n * sizeof(double) + 1),
+				 malloc(cells.n * sizeof(double) + 1), malloc(cells.n * sizeof(double) + 1) };
+	static struct job job; // holds a batch per possible worker
+
+	if (!fields.vsi || !fields.porosity || !fields.viscous || !fields.inertial) {
+		Message("Fields: out of memory\n");
+		return EXIT_FAILURE;
+	}
+
+	job.params = &params;
+	gob_panel_frame_of(&job.frame, &params);
+	job.cells = &cells;
+	job.fields = &fields;
+	LAYOUT(&job.layout, &params);
+	gob_property_model_init(&job.model, &params);
+	fits_batch_set_precision(params.fit_precision);
+
+	const double START = seconds();
+
+	struct vsi_raster raster = { 0 };
+
+	if (params.vsi_raster_spacing > 0 &&
+	    vsi_raster_build(&raster, job.layout.at, job.layout.BOX, job.layout.half_width, job.layout.length,
+			     params.vsi_raster_spacing, params.max_vsi))
+		job.raster = &raster;
+
+	const long N_CHUNKS = (cells.n + CHUNK_CELLS - 1) / CHUNK_CELLS;
+	const int WORKERS = pool_run(threads, N_CHUNKS, evaluate_chunk, &job);
+
+	const double ELAPSED = seconds() - START;
+
+	for (int w = 0; w < POOL_MAX_WORKERS; ++w)
+		vsi_batch_free(&job.batches[w]);
+
+	vsi_raster_free(&raster);
+
+	if (job.failed) {
+		Message("Fields: out of memory in %d chunks\n", job.failed);
+		return EXIT_FAILURE;
+	}
+
+	double volume = 0, min_vsi = INFINITY, max_vsi = -INFINITY;
+
+	for (long i = 0; i < cells.n; ++i) {
+		volume += cells.volume[i];
+		min_vsi = fields.vsi[i] < min_vsi ? fields.vsi[i] : min_vsi;
+		max_vsi = fields.vsi[i] > max_vsi ? fields.vsi[i] : max_vsi;
+	}
+
+	Message("Cells: %ld (%g m^3), VSI from %g to %g\n", cells.n, volume, min_vsi, max_vsi);
+	Message("Evaluated in %.3f s on %d threads (%.3g cells/s)\n", ELAPSED, WORKERS,
+		ELAPSED > 0 ? cells.n / ELAPSED : 0.0);
+
+	if (params.fit_precision != FITS_PRECISION_EXACT)
+		Message("Fit precision %d: sampled error %g of max(|fit|, 1) against the exact fits\n",
+			params.fit_precision, fits_batch_precision_error());
+
+	return write_fields(argv[optind + 1], &cells, &fields) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file pool.c
+ *
+ * @brief Work-stealing thread pool.
+ *
+ * Each worker's share is a [begin, end) range packed into one 64-bit atomic
+ * (begin in the high half), so the owner popping from the front and thieves
+ * splitting off the back are each a single compare-and-swap.
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "pool.h"
+
+#define RANGE(begin, end) (((uint64_t)(begin) << 32) | (uint64_t)(end))
+#define RANGE_BEGIN(range) ((long)((range) >> 32))
+#define RANGE_END(range) ((long)((range)&0xffffffffu))
+
+/* one cache line per share, so owners popping do not slow each other down */
+struct share {
+	_Alignas(64) _Atomic uint64_t range;
+};
+
+struct pool {
+	int workers;
+	pool_task_fn task;
+	void *context;
+	struct share shares[POOL_MAX_WORKERS];
+};
+
+struct worker {
+	struct pool *pool;
+	int index;
+};
+
+/* takes the first chunk of a worker's own share; -1 if it is empty */
+static long pop_front(_Atomic uint64_t *share)
+{
+	uint64_t range = atomic_load(share);
+
+	while (RANGE_BEGIN(range) < RANGE_END(range))
+		if (atomic_compare_exchange_weak(share, &range, RANGE(RANGE_BEGIN(range) + 1, RANGE_END(range))))
+			return RANGE_BEGIN(range);
+
+	return -1;
+}
+
+/* splits the back half off the largest other share into the thief's own; false if all are empty */
+static bool steal(struct pool *pool, const int thief)
+{
+	for (;;) {
+		int victim = -1;
+		long most = 0;
+
+		for (int w = 0; w < pool->workers; ++w) {
+			const uint64_t SHARE = atomic_load(&pool->shares[w].range);
+			const long LEFT = RANGE_END(SHARE) - RANGE_BEGIN(SHARE);
+
+			if (w != thief && LEFT > most) {
+				most = LEFT;
+				victim = w;
+			}
+		}
+
+		if (victim < 0)
+			return false;
+
+		uint64_t range = atomic_load(&pool->shares[victim].range);
+		const long BEGIN = RANGE_BEGIN(range);
+		const long END = RANGE_END(range);
+
+		if (BEGIN >= END)
+			continue; // drained meanwhile, look again
+
+		// the victim keeps the front half (a single chunk goes to the thief)
+		const long MID = BEGIN + (END - BEGIN) / 2;
+
+		if (atomic_compare_exchange_strong(&pool->shares[victim].range, &range, RANGE(BEGIN, MID))) {
+			atomic_store(&pool->shares[thief].range, RANGE(MID, END));
+			return true;
+		}
+	}
+}
+
+static void *work(void *arg)
+{
+	const struct worker *self = arg;
+	struct pool *pool = self->pool;
+
+	do {
+		long chunk;
+
+		while ((chunk = pop_front(&pool->shares[self->index].range)) >= 0)
+			pool->task(pool->context, self->index, chunk);
+	} while (steal(pool, self->index));
+
+	return NULL;
+}
+
+int pool_run(int workers, const long n_chunks, const pool_task_fn task, void *context)
+{
+	static struct pool pool; // too large for the stack; one run at a time
+
+	workers = workers < 1 ? 1 : (workers > POOL_MAX_WORKERS ? POOL_MAX_WORKERS : workers);
+
+	pool.workers = workers;
+	pool.task = task;
+	pool.context = context;
+
+	// equal contiguous shares to start with
+	for (int w = 0; w < workers; ++w)
+		atomic_store(&pool.shares[w].range, RANGE(n_chunks * w / workers, n_chunks * (w + 1) / workers));
+
+	pthread_t threads[POOL_MAX_WORKERS];
+	struct worker selves[POOL_MAX_WORKERS];
+	int started = 1;
+
+	for (int w = 0; w < workers; ++w)
+		selves[w] = (struct worker){ .pool = &pool, .index = w };
+
+	for (; started < workers; ++started)
+		if (pthread_create(&threads[started], NULL, work, &selves[started]) != 0)
+			break;
+
+	// shares of workers that failed to start are stolen like any other
+	work(&selves[0]);
+
+	for (int w = 1; w < started; ++w)
+		pthread_join(threads[w], NULL);
+
+	return started;
+}
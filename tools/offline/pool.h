@@ -0,0 +1,39 @@
+/**
+ * @file pool.h
+ *
+ * @brief Work-stealing thread pool over a range of chunk indices. Each worker
+ * starts with an equal share of the chunks and takes them from the front;
+ * once its share is used up it steals the back half of the largest share
+ * left, so uneven chunks (cells outside the panel are cheap, blend regions
+ * are not) still keep every worker busy to the end.
+ */
+
+#ifndef GOB_OFFLINE_POOL_H
+#define GOB_OFFLINE_POOL_H
+
+/* upper bound on workers */
+#define POOL_MAX_WORKERS 256
+
+/**
+ * @brief Runs one chunk.
+ *
+ * @param [in,out] context shared state passed to pool_run
+ * @param [in] worker index of the worker running the chunk (0 .. workers - 1)
+ * @param [in] chunk chunk index (0 .. n_chunks - 1)
+ */
+typedef void (*pool_task_fn)(void *context, int worker, long chunk);
+
+/**
+ * @brief Runs every chunk exactly once across the workers and waits for all
+ * of them. The calling thread is worker 0; if some worker threads cannot be
+ * started, the others take over their chunks.
+ *
+ * @param [in] workers number of workers (clamped to 1 .. POOL_MAX_WORKERS)
+ * @param [in] n_chunks number of chunks (< 2^32)
+ * @param [in] task chunk function
+ * @param [in,out] context passed through to task
+ * @return [int] number of workers that ran
+ */
+int pool_run(int workers, long n_chunks, pool_task_fn task, void *context);
+
+#endif // GOB_OFFLINE_POOL_H
@@ -0,0 +1,199 @@
+/**
+ * @file rp.c
+ *
+ * @brief RP variable table behind the udf.h stand-in.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "udf.h"
+
+#define RP_MAX_VARIABLES 512
+#define RP_MAX_NAME 96
+#define RP_MAX_VALUE 256
+
+struct rp_variable {
+	char name[RP_MAX_NAME];
+	char value[RP_MAX_VALUE]; // as written, quotes removed from strings
+};
+
+static struct rp_variable variables[RP_MAX_VARIABLES];
+static int n_variables = 0;
+
+static const struct rp_variable *find(const char *name)
+{
+	for (int i = 0; i < n_variables; ++i)
+		if (strcmp(variables[i].name, name) == 0)
+			return &variables[i];
+
+	return NULL;
+}
+
+static void set(const char *name, const char *value)
+{
+	struct rp_variable *variable = (struct rp_variable *)find(name);
+
+	if (!variable) {
+		if (n_variables == RP_MAX_VARIABLES) {
+			Message("RP: too many variables, %s ignored\n", name);
+			return;
+		}
+
+		variable = &variables[n_variables++];
+		snprintf(variable->name, sizeof(variable->name), "%s", name);
+	}
+
+	snprintf(variable->value, sizeof(variable->value), "%s", value);
+}
+
+/* copies the token at *p (a "string" or up to whitespace/')') into out; NULL if there is none */
+static const char *token(const char *p, char *out, const size_t size)
+{
+	size_t n = 0;
+
+	p += strspn(p, " \t");
+
+	const bool QUOTED = *p == '"';
+
+	if (QUOTED) {
+		for (++p; *p && *p != '"'; ++p)
+			if (n + 1 < size)
+				out[n++] = *p;
+
+		if (*p != '"')
+			return NULL;
+
+		++p;
+	} else {
+		for (; *p && *p != ' ' && *p != '\t' && *p != ')' && *p != '\n' && *p != '\r'; ++p)
+			if (n + 1 < size)
+				out[n++] = *p;
+	}
+
+	out[n] = '\0';
+	return n || QUOTED ? p : NULL;
+}
+
+/* a literal value: number, #t/#f or a string (not a computed expression or list) */
+static bool literal(const char *line_value, const char *value)
+{
+	if (line_value[0] == '"')
+		return true;
+
+	if (strcmp(value, "#t") == 0 || strcmp(value, "#f") == 0)
+		return true;
+
+	char *end;
+	strtod(value, &end);
+
+	return end != value && *end == '\0';
+}
+
+static void parse_line(const char *line)
+{
+	char name[RP_MAX_NAME];
+	char value[RP_MAX_VALUE];
+	const char *p = line;
+
+	while (*p == ' ' || *p == '\t')
+		++p;
+
+	if (strncmp(p, "(make-new-rpvar '", 17) == 0)
+		p += 17;
+	else if (strncmp(p, "(rpsetvar '", 11) == 0)
+		p += 11;
+	else if (*p == '(' || *p == ';' || *p == '#' || *p == '\0' || *p == '\n')
+		return; // other Scheme, or a comment
+
+	if (!(p = token(p, name, sizeof(name))))
+		return;
+
+	while (*p == ' ' || *p == '\t')
+		++p;
+
+	const char *line_value = p;
+
+	if (!token(p, value, sizeof(value)) || !literal(line_value, value))
+		return;
+
+	set(name, value);
+}
+
+bool rp_load(const char *path)
+{
+	FILE *file = fopen(path, "r");
+
+	if (!file) {
+		Message("RP: could not open %s\n", path);
+		return false;
+	}
+
+	char line[1024];
+
+	while (fgets(line, sizeof(line), file))
+		parse_line(line);
+
+	fclose(file);
+	return true;
+}
+
+bool RP_Variable_Exists_P(const char *name)
+{
+	return find(name) != NULL;
+}
+
+real RP_Get_Real(const char *name)
+{
+	const struct rp_variable *variable = find(name);
+
+	return variable ? strtod(variable->value, NULL) : 0;
+}
+
+int RP_Get_Integer(const char *name)
+{
+	const struct rp_variable *variable = find(name);
+
+	return variable ? (int)strtol(variable->value, NULL, 10) : 0;
+}
+
+bool RP_Get_Boolean(const char *name)
+{
+	const struct rp_variable *variable = find(name);
+
+	// #t, or a nonzero number in a plain "name value" line
+	return variable && (strcmp(variable->value, "#t") == 0 || strtod(variable->value, NULL) != 0);
+}
+
+const char *RP_Get_String(const char *name)
+{
+	const struct rp_variable *variable = find(name);
+
+	return variable ? variable->value : "";
+}
+
+void RP_Set_Real(const char *name, const real value)
+{
+	char text[32];
+
+	snprintf(text, sizeof(text), "%.17g", value);
+	set(name, text);
+}
+
+void RP_Set_Integer(const char *name, const int value)
+{
+	char text[16];
+
+	snprintf(text, sizeof(text), "%d", value);
+	set(name, text);
+}
+
+void RP_Set_Boolean(const char *name, const bool value)
+{
+	set(name, value ? "#t" : "#f");
+}
+
+void RP_Set_String(const char *name, const char *value)
+{
+	set(name, value);
+}
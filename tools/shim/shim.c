@@ -0,0 +1,66 @@
+/**
+ * @file shim.c
+ *
+ * @brief Mesh and solver state behind the udf.h stand-in.
+ */
+
+#include <stdlib.h>
+
+#include "udf.h"
+
+Domain shim_domain = { .c = NULL };
+int shim_iteration = 0;
+real shim_time = 0;
+
+Thread *shim_thread_new(const int id, const int n_elements)
+{
+	Thread *t = calloc(1, sizeof(*t));
+
+	if (!t)
+		return NULL;
+
+	// one spare row, so empty threads still get valid pointers
+	const size_t ROWS = (size_t)n_elements + 1;
+
+	t->id = id;
+	t->n_elements = n_elements;
+	t->centroid = calloc(ROWS, sizeof(*t->centroid));
+	t->volume = calloc(ROWS, sizeof(*t->volume));
+	t->udm = calloc(ROWS * SHIM_MAX_UDM, sizeof(*t->udm));
+	t->yi = calloc(ROWS * SHIM_MAX_SPECIES, sizeof(*t->yi));
+	t->profile = calloc(ROWS, sizeof(*t->profile));
+
+	if (!t->centroid || !t->volume || !t->udm || !t->yi || !t->profile) {
+		free(t->centroid);
+		free(t->volume);
+		free(t->udm);
+		free(t->yi);
+		free(t->profile);
+		free(t);
+		return NULL;
+	}
+
+	// keep the threads in creation order
+	Thread **last = &shim_domain.c;
+
+	while (*last)
+		last = &(*last)->next;
+
+	*last = t;
+	return t;
+}
+
+void shim_domain_clear(void)
+{
+	while (shim_domain.c) {
+		Thread *t = shim_domain.c;
+
+		shim_domain.c = t->next;
+		free(t->centroid);
+		free(t->volume);
+		free(t->udm);
+		free(t->yi);
+		free(t->profile);
+		free(t);
+	}
+}
@@ -0,0 +1,159 @@
+/**
+ * @file udf.h
+ *
+ * @brief Stand-in for Fluent's udf.h, so the UDF sources build and run as a
+ * plain (serial, 3D, double precision) program: the offline evaluator and
+ * the benchmarks compile the unmodified UDF sources against it.
+ *
+ * Cell threads are plain arrays (shim_thread_new), RP variables live in a
+ * name/value table (rp_load, RP_Set_*), and everything parallel is the
+ * serial identity: the reductions return their argument and the host/node
+ * transfers do nothing. Only what the UDF uses is provided.
+ */
+
+#ifndef GOB_SHIM_UDF_H
+#define GOB_SHIM_UDF_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+/* serial process: neither host nor node */
+#define RP_HOST 0
+#define RP_NODE 0
+#define PARALLEL 0
+
+#define RP_3D 1
+#define ND_ND 3
+
+/* slots per cell */
+#define SHIM_MAX_UDM 16
+#define SHIM_MAX_SPECIES 8
+
+typedef double real; // double precision solver
+
+typedef int cell_t;
+
+typedef struct thread_struct {
+	int id;
+	int n_elements;
+	real (*centroid)[ND_ND];
+	real *volume;
+	real *udm; // n_elements rows of SHIM_MAX_UDM
+	real *yi; // n_elements rows of SHIM_MAX_SPECIES mass fractions
+	real *profile; // target of C_PROFILE
+	struct thread_struct *next;
+} Thread;
+
+typedef struct domain_struct {
+	Thread *c; // cell threads
+} Domain;
+
+extern Domain shim_domain;
+extern int shim_iteration; // N_ITER
+extern real shim_time; // CURRENT_TIME
+
+/**
+ * @brief Appends a cell thread with zeroed storage to shim_domain.
+ *
+ * @param [in] id zone id
+ * @param [in] n_elements number of cells
+ * @return [Thread *] the thread, NULL if out of memory
+ */
+Thread *shim_thread_new(const int id, const int n_elements);
+
+/**
+ * @brief Releases every cell thread of shim_domain.
+ */
+void shim_domain_clear(void);
+
+/* mesh */
+#define Get_Domain(id) (&shim_domain)
+#define THREAD_ID(t) ((t)->id)
+#define THREAD_N_ELEMENTS(t) ((t)->n_elements)
+#define THREAD_N_ELEMENTS_INT(t) ((t)->n_elements)
+
+#define thread_loop_c(t, d) for ((t) = (d)->c; (t); (t) = (t)->next)
+
+/* like Fluent, a cell loop opens a block that end_c_loop closes */
+#define begin_c_loop(c, t) { for ((c) = 0; (c) < (t)->n_elements; ++(c))
+#define end_c_loop(c, t) }
+#define begin_c_loop_int(c, t) begin_c_loop(c, t)
+#define end_c_loop_int(c, t) end_c_loop(c, t)
+
+/* cell data */
+#define C_CENTROID(x, c, t)                            \
+	do {                                           \
+		for (int i_ = 0; i_ < ND_ND; ++i_)     \
+			(x)[i_] = (t)->centroid[c][i_]; \
+	} while (0)
+#define C_VOLUME(c, t) ((t)->volume[c])
+#define C_UDMI(c, t, i) ((t)->udm[(size_t)(c)*SHIM_MAX_UDM + (i)])
+#define C_YI(c, t, i) ((t)->yi[(size_t)(c)*SHIM_MAX_SPECIES + (i)])
+#define C_PROFILE(c, t, i) ((t)->profile[c])
+
+/* nodes: a cell's only node is its centroid */
+typedef struct {
+	real x[ND_ND];
+} Node;
+
+#define c_node_loop(c, t, n) for ((n) = 0; (n) < 1; ++(n))
+#define C_NODE(c, t, n) ((Node *)(t)->centroid[c])
+#define NODE_X(v) ((v)->x[0])
+#define NODE_Y(v) ((v)->x[1])
+
+/* solver state */
+#define N_ITER shim_iteration
+#define CURRENT_TIME shim_time
+
+/* UDF entry points become plain functions */
+#define DEFINE_PROFILE(name, t, i) void name(Thread *t, int i)
+#define DEFINE_ADJUST(name, d) void name(Domain *d)
+#define DEFINE_EXECUTE_FROM_GUI(name, libname, mode) void name(char *libname, int mode)
+#define DEFINE_EXECUTE_AT_END(name) void name(void)
+#define DEFINE_ON_DEMAND(name) void name(void)
+
+/* console */
+#define Message printf
+#define Message0 printf
+
+/* parallel: one process holds every cell */
+#define myid 0
+#define I_AM_NODE_ZERO_P 1
+
+#define PRF_GRSUM1(x) (x)
+#define PRF_GRLOW1(x) (x)
+#define PRF_GRHIGH1(x) (x)
+#define PRF_GISUM1(x) (x)
+#define PRF_GILOW1(x) (x)
+#define PRF_GIHIGH1(x) (x)
+#define PRF_GRSUM(x, n, work) ((void)(work))
+#define PRF_GRLOW(x, n, work) ((void)(work))
+#define PRF_GRHIGH(x, n, work) ((void)(work))
+#define host_to_node_real(x, n) ((void)(x))
+#define node_to_host_real(x, n) ((void)(x))
+
+/* RP variables; unset ones read as 0, false or "" */
+bool RP_Variable_Exists_P(const char *name);
+real RP_Get_Real(const char *name);
+int RP_Get_Integer(const char *name);
+bool RP_Get_Boolean(const char *name);
+const char *RP_Get_String(const char *name);
+void RP_Set_Real(const char *name, const real value);
+void RP_Set_Integer(const char *name, const int value);
+void RP_Set_Boolean(const char *name, const bool value);
+void RP_Set_String(const char *name, const char *value);
+
+/**
+ * @brief Sets RP variables from a file. Understands the lines of the GUI
+ * script, (make-new-rpvar 'name value 'type) and (rpsetvar 'name value), as
+ * well as plain "name value" lines; values are numbers, #t/#f or "strings".
+ * Anything else (computed values, comments) is skipped. Later settings
+ * override earlier ones.
+ *
+ * @param [in] path file to read
+ * @return [true] file read
+ * @return [false] file could not be opened (reported)
+ */
+bool rp_load(const char *path);
+
+#endif // GOB_SHIM_UDF_H